@@ -0,0 +1,359 @@
+// Benchmark da libfreqcomp: mede apply_fir_filter, downsample, polyphase_decimate, o Decimator e o
+// Resampler em fluxo contínuo e, quando a biblioteca tem FFTW, computeFFT, computeIFFT e
+// reduceFrequency. Varre tamanhos de sinal, número de coeficientes, fatores de decimação e número
+// de canais, e informa amostras/s, ns/amostra e bytes alocados por chamada. Com --json grava os
+// resultados em JSON para comparar versões.
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "freqcomp/freqcomp.h"
+
+#define PI 3.14159265358979323846
+
+// ---- Contagem de alocações ----
+// operator new/delete globais substituídos para somar os bytes pedidos ao heap durante as medições
+
+static std::atomic<unsigned long long> allocated_bytes(0);
+static std::atomic<unsigned long long> allocation_count(0);
+
+void* operator new(std::size_t size) {
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+// ---- Medição ----
+
+struct Result {
+    std::string name;
+    std::string function;
+    long long length;      // Quadros de entrada por chamada
+    int taps;              // 0 quando não se aplica
+    int factor;            // Fator de decimação (ou M da razão L/M); 0 quando não se aplica
+    int channels;
+    long long iterations;
+    double ns_per_iteration;
+    double ns_per_sample;  // Por amostra de entrada (quadros x canais)
+    double samples_per_second;
+    double bytes_per_iteration;
+    double allocations_per_iteration;
+};
+
+// Impede que o compilador descarte o resultado das chamadas medidas
+static volatile double sink;
+
+static double checksum(const std::vector<double>& v) {
+    return v.empty() ? 0.0 : v[v.size() / 2];
+}
+
+#ifdef FREQCOMP_HAVE_FFTW
+static double checksum(const std::vector<std::complex<double>>& v) {
+    return v.empty() ? 0.0 : v[v.size() / 2].real();
+}
+#endif
+
+class Bench {
+public:
+    Bench(double min_time, const std::string& filter) : min_time(min_time), filter(filter) {}
+
+    // Executa body uma vez para aquecer (planos FFTW, caches, capacidade dos buffers) e depois
+    // repete até somar min_time segundos
+    void run(const std::string& name, const std::string& function, long long length, int taps, int factor, int channels,
+             const std::function<void()>& body) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            return;
+        }
+        body();
+
+        unsigned long long bytes_before = allocated_bytes.load();
+        unsigned long long count_before = allocation_count.load();
+        long long iterations = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            body();
+            iterations++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < min_time);
+        unsigned long long bytes = allocated_bytes.load() - bytes_before;
+        unsigned long long count = allocation_count.load() - count_before;
+
+        Result r;
+        r.name = name;
+        r.function = function;
+        r.length = length;
+        r.taps = taps;
+        r.factor = factor;
+        r.channels = channels;
+        r.iterations = iterations;
+        r.ns_per_iteration = elapsed * 1e9 / iterations;
+        r.ns_per_sample = r.ns_per_iteration / ((double) length * channels);
+        r.samples_per_second = 1e9 / r.ns_per_sample;
+        r.bytes_per_iteration = (double) bytes / iterations;
+        r.allocations_per_iteration = (double) count / iterations;
+        results.push_back(r);
+
+        std::cout << std::left << std::setw(52) << name << std::right << std::fixed
+                  << std::setw(10) << std::setprecision(3) << r.ns_per_sample << " ns/amostra"
+                  << std::setw(10) << std::setprecision(1) << r.samples_per_second / 1e6 << " M amostras/s"
+                  << std::setw(14) << std::setprecision(0) << r.bytes_per_iteration << " B/chamada"
+                  << std::setw(8) << iterations << " iter" << std::endl;
+    }
+
+    const std::vector<Result>& all() const { return results; }
+
+private:
+    double min_time;
+    std::string filter;
+    std::vector<Result> results;
+};
+
+// ---- Casos ----
+
+static std::vector<double> test_signal(long long frames, int channels) {
+    // Tom de 440 Hz mais ruído, com semente fixa para as execuções serem comparáveis
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> noise(-0.1, 0.1);
+    std::vector<double> signal((size_t) frames * channels);
+    for (long long n = 0; n < frames; n++) {
+        for (int c = 0; c < channels; c++) {
+            signal[(size_t) n * channels + c] = 0.5 * std::sin(2 * PI * 440 * (c + 1) * n / 44100.0) + noise(rng);
+        }
+    }
+    return signal;
+}
+
+static std::string case_name(const std::string& function, long long length, int taps, int factor, int channels) {
+    std::ostringstream name;
+    name << function << "/n=" << length;
+    if (taps) name << "/taps=" << taps;
+    if (factor) name << "/fator=" << factor;
+    if (channels > 1) name << "/canais=" << channels;
+    return name.str();
+}
+
+static void bench_filters(Bench& bench, const std::vector<long long>& lengths) {
+    const int taps_sweep[] = {15, 63, 255};
+    const int factor_sweep[] = {2, 3, 4, 8};
+
+    for (long long length : lengths) {
+        std::vector<double> signal = test_signal(length, 1);
+        for (int taps : taps_sweep) {
+            std::vector<double> coefficients = freqcomp::generate_fir_coefficients(taps - 1, 8000, 44100);
+            bench.run(case_name("apply_fir_filter", length, taps, 0, 1), "apply_fir_filter", length, taps, 0, 1,
+                      [&] { sink = checksum(freqcomp::apply_fir_filter(signal, coefficients)); });
+        }
+        for (int factor : factor_sweep) {
+            bench.run(case_name("downsample", length, 0, factor, 1), "downsample", length, 0, factor, 1,
+                      [&] { sink = checksum(freqcomp::downsample(signal, factor)); });
+        }
+    }
+
+    // Decimação polifásica: o custo cai com o fator, ao contrário de filtrar e depois decimar
+    long long length = 65536;
+    std::vector<double> signal = test_signal(length, 1);
+    for (int taps : taps_sweep) {
+        for (int factor : factor_sweep) {
+            std::vector<double> coefficients = freqcomp::generate_fir_coefficients(taps - 1, 0.45 * 44100 / factor, 44100);
+            bench.run(case_name("polyphase_decimate", length, taps, factor, 1), "polyphase_decimate", length, taps, factor, 1,
+                      [&] { sink = checksum(freqcomp::polyphase_decimate(signal, coefficients, factor)); });
+        }
+    }
+}
+
+// Decimator e Resampler em blocos de 4096 quadros com buffers reaproveitados: depois do
+// aquecimento, não deveriam alocar nada
+template <typename Sample>
+static void bench_streaming(Bench& bench, const std::string& suffix) {
+    const long long length = 65536;
+    const int block = 4096;
+    const int channel_sweep[] = {1, 2, 6};
+    const int factor_sweep[] = {2, 3, 4, 8};
+    const int taps = 63;
+
+    for (int channels : channel_sweep) {
+        std::vector<double> source = test_signal(length, channels);
+        std::vector<Sample> signal(source.begin(), source.end());
+
+        for (int factor : factor_sweep) {
+            std::vector<double> coefficients = freqcomp::generate_fir_coefficients(taps - 1, 0.45 * 44100 / factor, 44100);
+            freqcomp::Decimator<Sample> decimator(coefficients, factor, channels);
+            std::vector<Sample> output((size_t) decimator.max_output(block) * channels);
+            std::string function = "Decimator<" + suffix + ">";
+            bench.run(case_name(function, length, taps, factor, channels), function, length, taps, factor, channels, [&] {
+                decimator.reset();
+                for (long long offset = 0; offset < length; offset += block) {
+                    int count = (int) std::min<long long>(block, length - offset);
+                    decimator.process(freqcomp::Span<const Sample>(signal.data() + offset * channels, (size_t) count * channels), output);
+                }
+                sink = output[0];
+            });
+        }
+
+        freqcomp::Resampler<Sample> resampler(44100, 16000, channels);
+        std::vector<Sample> output((size_t) resampler.max_output(block) * channels);
+        std::string function = "Resampler<" + suffix + ">";
+        bench.run(case_name(function + "/44100->16000", length, 0, resampler.decimation(), channels), function, length, 0,
+                  resampler.decimation(), channels, [&] {
+            resampler.reset();
+            for (long long offset = 0; offset < length; offset += block) {
+                int count = (int) std::min<long long>(block, length - offset);
+                resampler.process(freqcomp::Span<const Sample>(signal.data() + offset * channels, (size_t) count * channels), output);
+            }
+            resampler.flush(output);
+            sink = output[0];
+        });
+    }
+}
+
+static void bench_resample(Bench& bench) {
+    const long long length = 65536;
+    const int rates[][2] = {{44100, 16000}, {44100, 22050}, {48000, 8000}};
+    std::vector<double> signal = test_signal(length, 1);
+    for (const int* r : rates) {
+        int input_rate = r[0], output_rate = r[1];
+        std::ostringstream name;
+        name << "resample_rational/" << input_rate << "->" << output_rate;
+        int factor = input_rate / freqcomp::gcd(input_rate, output_rate);
+        bench.run(case_name(name.str(), length, 0, factor, 1), "resample_rational", length, 0, factor, 1,
+                  [&] { sink = checksum(freqcomp::resample_rational(signal, input_rate, output_rate)); });
+    }
+}
+
+#ifdef FREQCOMP_HAVE_FFTW
+static void bench_spectrum(Bench& bench, const std::vector<long long>& lengths) {
+    for (long long length : lengths) {
+        std::vector<double> signal = test_signal(length, 1);
+        std::vector<std::complex<double>> spectrum = freqcomp::computeFFT(signal);
+        bench.run(case_name("computeFFT", length, 0, 0, 1), "computeFFT", length, 0, 0, 1,
+                  [&] { sink = checksum(freqcomp::computeFFT(signal)); });
+        bench.run(case_name("computeIFFT", length, 0, 0, 1), "computeIFFT", length, 0, 0, 1,
+                  [&] { sink = checksum(freqcomp::computeIFFT(spectrum, length)); });
+        bench.run(case_name("reduceFrequency", length, 0, 0, 1), "reduceFrequency", length, 0, 0, 1,
+                  [&] { sink = checksum(freqcomp::reduceFrequency(spectrum, 44100, 16000)); });
+    }
+}
+#endif
+
+// ---- Saída JSON ----
+
+static std::string json_string(const std::string& s) {
+    std::string out = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out + "\"";
+}
+
+static bool write_json(const std::string& path, const std::vector<Result>& results, double min_time) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    file << std::setprecision(10);
+    file << "{\n  \"context\": {\n"
+         << "    \"date\": " << json_string(date) << ",\n"
+#ifdef __VERSION__
+         << "    \"compiler\": " << json_string(__VERSION__) << ",\n"
+#endif
+         << "    \"fir_kernel\": " << json_string(freqcomp::selected_fir_kernel().name) << ",\n"
+#ifdef FREQCOMP_HAVE_FFTW
+         << "    \"fftw\": true,\n"
+#else
+         << "    \"fftw\": false,\n"
+#endif
+         << "    \"min_time\": " << min_time << "\n  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        file << "    {\"name\": " << json_string(r.name) << ", \"function\": " << json_string(r.function)
+             << ", \"length\": " << r.length << ", \"taps\": " << r.taps << ", \"factor\": " << r.factor
+             << ", \"channels\": " << r.channels << ", \"iterations\": " << r.iterations
+             << ", \"ns_per_iteration\": " << r.ns_per_iteration << ", \"ns_per_sample\": " << r.ns_per_sample
+             << ", \"samples_per_second\": " << r.samples_per_second << ", \"bytes_per_iteration\": " << r.bytes_per_iteration
+             << ", \"allocations_per_iteration\": " << r.allocations_per_iteration << "}"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+    return (bool) file;
+}
+
+int main(int argc, char* argv[]) {
+    std::string json_path;
+    std::string filter;
+    double min_time = 0.2;
+    bool quick = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--filtro" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--tempo-min" && i + 1 < argc) {
+            min_time = std::stod(argv[++i]);
+        } else if (arg == "--rapido") {
+            quick = true;
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--json <arquivo.json>] [--filtro <trecho do nome>] [--tempo-min <segundos>] [--rapido]\n";
+            return 1;
+        }
+    }
+
+    // --rapido mede só os sinais curtos, para conferir que tudo roda
+    std::vector<long long> lengths = {4096, 65536, 1048576};
+    if (quick) {
+        lengths = {4096};
+        min_time = std::min(min_time, 0.01);
+    }
+
+    std::cout << "Núcleo FIR: " << freqcomp::selected_fir_kernel().name << std::endl;
+    Bench bench(min_time, filter);
+    bench_filters(bench, lengths);
+    bench_streaming<double>(bench, "double");
+    bench_streaming<float>(bench, "float");
+    bench_resample(bench);
+#ifdef FREQCOMP_HAVE_FFTW
+    bench_spectrum(bench, lengths);
+#endif
+
+    if (!json_path.empty()) {
+        if (!write_json(json_path, bench.all(), min_time)) {
+            std::cerr << "Erro ao gravar o arquivo JSON!" << std::endl;
+            return 1;
+        }
+        std::cout << "Resultados salvos em " << json_path << std::endl;
+    }
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/freqcomp_bench --json media/bench.json
+// ./build/freqcomp_bench --filtro Decimator --tempo-min 1
@@ -0,0 +1,124 @@
+#ifndef COMMON_AUDIO_SOURCE_H
+#define COMMON_AUDIO_SOURCE_H
+
+// Leitura de WAV (libsndfile) e MP3 (mpg123) em memória, compartilhada pelos exemplos 9, 10 e 12
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <mpg123.h>
+#include <sndfile.h>
+
+// Fonte de áudio em quadros intercalados (double). Arquivos WAV são lidos com libsndfile; arquivos
+// MP3 são decodificados com mpg123_read direto na memória, sem WAV intermediário em disco.
+// Amostras do MP3 são pedidas em 16 bits e convertidas como o libsndfile faz (divisão por 32768).
+class AudioSource {
+public:
+    AudioSource() : file(nullptr), decoder(nullptr) {}
+
+    ~AudioSource() {
+        if (file) {
+            sf_close(file);
+        }
+        if (decoder) {
+            mpg123_close(decoder);
+            mpg123_delete(decoder);
+        }
+    }
+
+    AudioSource(const AudioSource&) = delete;
+    AudioSource& operator=(const AudioSource&) = delete;
+
+    bool open(const std::string& path) {
+        std::string extension = path.substr(path.find_last_of(".") + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension != "mp3") {
+            info = SF_INFO();
+            file = sf_open(path.c_str(), SFM_READ, &info);
+            if (!file) {
+                std::cerr << "Erro ao abrir o arquivo WAV: " << path << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        int err;
+        if ((decoder = mpg123_new(nullptr, &err)) == nullptr) {
+            std::cerr << "Erro ao inicializar mpg123!" << std::endl;
+            return false;
+        }
+        if (mpg123_open(decoder, path.c_str()) != MPG123_OK) {
+            std::cerr << "Erro ao abrir arquivo MP3: " << path << std::endl;
+            return false;
+        }
+
+        // Fixa a saída do decodificador em 16 bits com a taxa e os canais do arquivo
+        long rate;
+        int channels, encoding;
+        if (mpg123_getformat(decoder, &rate, &channels, &encoding) != MPG123_OK) {
+            std::cerr << "Erro ao ler o formato do MP3: " << path << std::endl;
+            return false;
+        }
+        mpg123_format_none(decoder);
+        mpg123_format(decoder, rate, channels, MPG123_ENC_SIGNED_16);
+
+        info = SF_INFO();
+        info.samplerate = rate;
+        info.channels = channels;
+        info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+        return true;
+    }
+
+    // Formato do áudio (para MP3, frames fica 0: a duração só é conhecida ao fim da decodificação)
+    const SF_INFO& format() const { return info; }
+
+    // Lê até "count" quadros; retorna quantos foram lidos (0 no fim do arquivo)
+    sf_count_t read(double* frames, sf_count_t count) {
+        if (file) {
+            return sf_readf_double(file, frames, count);
+        }
+
+        size_t wanted = (size_t) count * info.channels;
+        pcm.resize(wanted);
+        size_t filled = 0;
+        while (filled < wanted) {
+            size_t bytes_read = 0;
+            int status = mpg123_read(decoder, reinterpret_cast<unsigned char*>(pcm.data() + filled),
+                                     (wanted - filled) * sizeof(short), &bytes_read);
+            filled += bytes_read / sizeof(short);
+            if (status != MPG123_OK && status != MPG123_NEW_FORMAT) {
+                break;
+            }
+        }
+        for (size_t i = 0; i < filled; i++) {
+            frames[i] = pcm[i] / 32768.0;
+        }
+        return filled / info.channels;
+    }
+
+    // Lê o restante do áudio de uma vez (quadros intercalados)
+    std::vector<double> read_all() {
+        const sf_count_t block_frames = 8192;
+        std::vector<double> frames;
+        sf_count_t total = 0;
+        for (;;) {
+            frames.resize((size_t) (total + block_frames) * info.channels);
+            sf_count_t frames_read = read(frames.data() + (size_t) total * info.channels, block_frames);
+            total += frames_read;
+            if (frames_read < block_frames) {
+                break;
+            }
+        }
+        frames.resize((size_t) total * info.channels);
+        return frames;
+    }
+
+private:
+    SNDFILE* file;
+    mpg123_handle* decoder;
+    SF_INFO info;
+    std::vector<short> pcm; // Saída do decodificador, reaproveitada entre as leituras
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef COMMON_LATENCY_STATS_H
+#define COMMON_LATENCY_STATS_H
+
+// Instrumentação de latência e jitter por probes de pad, compartilhada pelos exemplos 4 e 5
+
+#include <gst/gst.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Histograma log-linear no estilo HDR: valores em ns com resolução de ~3% (32 sub-intervalos por
+// potência de 2) até ~1 h. Os contadores são atômicos: a thread de streaming grava e a principal
+// lê para imprimir, sem lock.
+class LatencyHistogram {
+public:
+    LatencyHistogram() : total(0), maximum(0) {
+        for (int i = 0; i < bucket_count; i++) {
+            buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record(uint64_t ns) {
+        buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        uint64_t current = maximum.load(std::memory_order_relaxed);
+        while (ns > current && !maximum.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max() const { return maximum.load(std::memory_order_relaxed); }
+
+    // Maior valor do intervalo que contém o percentil p (0 a 100), limitado ao máximo observado
+    uint64_t percentile(double p) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        uint64_t target = std::max<uint64_t>(1, (uint64_t) std::ceil(p / 100.0 * n));
+        uint64_t seen = 0;
+        for (int i = 0; i < bucket_count; i++) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                return std::min(bucket_upper(i), max());
+            }
+        }
+        return max();
+    }
+
+private:
+    static const int sub_bits = 5;
+    static const int bucket_count = 1216; // Valores até 2^42 ns
+
+    // Abaixo de 64 ns, um intervalo por valor; acima, os 6 bits mais altos escolhem o intervalo
+    static int bucket_index(uint64_t ns) {
+        if (ns < (1u << (sub_bits + 1))) return (int) ns;
+        int shift = 63 - __builtin_clzll(ns) - sub_bits;
+        return std::min(bucket_count - 1, (int) (shift * (1 << sub_bits) + (ns >> shift)));
+    }
+
+    static uint64_t bucket_upper(int index) {
+        if (index < (1 << (sub_bits + 1))) return index;
+        int shift = index / (1 << sub_bits) - 1;
+        uint64_t sub = index - shift * (1 << sub_bits);
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::atomic<uint64_t> buckets[bucket_count];
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> maximum;
+};
+
+// Medidas de um elemento, com probes no pad sink (chegada) e no pad src (saída):
+// - latência: atraso do buffer em relação ao relógio do pipeline, running time atual menos o PTS
+//   (a fonte ao vivo marca o PTS com o running time da captura);
+// - jitter: diferença entre o intervalo de chegada de dois buffers seguidos e a duração do buffer;
+// - processamento: tempo entre a chegada no pad sink e a saída no pad src, na mesma thread.
+struct StageStats {
+    const char *name;
+    std::atomic<int64_t> entry_ns;     // Chegada do buffer em processamento
+    std::atomic<int64_t> last_exit_ns; // Saída do buffer anterior
+    LatencyHistogram latency_in;
+    LatencyHistogram latency_out;
+    LatencyHistogram jitter;
+    LatencyHistogram processing;
+
+    explicit StageStats(const char *name) : name(name), entry_ns(0), last_exit_ns(0) {}
+};
+
+inline int64_t monotonic_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Running time do pipeline agora menos o PTS do buffer
+inline void record_latency(GstPad *pad, GstBuffer *buffer, LatencyHistogram &histogram) {
+    GstElement *element = GST_ELEMENT(GST_PAD_PARENT(pad));
+    if (!element || !GST_BUFFER_PTS_IS_VALID(buffer)) return;
+    GstClock *clock = gst_element_get_clock(element);
+    if (!clock) return;
+    GstClockTime running_time = gst_clock_get_time(clock) - gst_element_get_base_time(element);
+    gst_object_unref(clock);
+    GstClockTime pts = GST_BUFFER_PTS(buffer);
+    histogram.record(running_time > pts ? running_time - pts : 0);
+}
+
+inline GstPadProbeReturn stage_entry_probe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data) {
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    if (!buffer) return GST_PAD_PROBE_OK;
+
+    StageStats *stats = static_cast<StageStats*>(user_data);
+    stats->entry_ns.store(monotonic_ns(), std::memory_order_relaxed);
+    record_latency(pad, buffer, stats->latency_in);
+    return GST_PAD_PROBE_OK;
+}
+
+inline GstPadProbeReturn stage_exit_probe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data) {
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    if (!buffer) return GST_PAD_PROBE_OK;
+
+    StageStats *stats = static_cast<StageStats*>(user_data);
+    int64_t now = monotonic_ns();
+    // O push no pad src acontece dentro do chain do pad sink: a chegada registrada é a deste buffer
+    stats->processing.record(std::max<int64_t>(0, now - stats->entry_ns.load(std::memory_order_relaxed)));
+    record_latency(pad, buffer, stats->latency_out);
+
+    int64_t previous = stats->last_exit_ns.exchange(now, std::memory_order_relaxed);
+    if (previous != 0 && GST_BUFFER_DURATION_IS_VALID(buffer)) {
+        int64_t interval = now - previous;
+        stats->jitter.record(std::llabs(interval - (int64_t) GST_BUFFER_DURATION(buffer)));
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+// Probes de entrada e saída de um elemento
+inline void instrument_element(GstElement *element, StageStats *stats) {
+    GstPad *sink_pad = gst_element_get_static_pad(element, "sink");
+    GstPad *src_pad = gst_element_get_static_pad(element, "src");
+    if (sink_pad) {
+        gst_pad_add_probe(sink_pad, GST_PAD_PROBE_TYPE_BUFFER, stage_entry_probe, stats, nullptr);
+        gst_object_unref(sink_pad);
+    }
+    if (src_pad) {
+        gst_pad_add_probe(src_pad, GST_PAD_PROBE_TYPE_BUFFER, stage_exit_probe, stats, nullptr);
+        gst_object_unref(src_pad);
+    }
+}
+
+inline void print_histogram(const char *label, const LatencyHistogram &histogram) {
+    std::cout << "  " << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(3)
+              << "p50 " << std::setw(9) << histogram.percentile(50) / 1e6 << " ms   "
+              << "p99 " << std::setw(9) << histogram.percentile(99) / 1e6 << " ms   "
+              << "máx " << std::setw(9) << histogram.max() / 1e6 << " ms" << std::endl;
+}
+
+inline void print_stats(const StageStats &stats) {
+    std::cout << stats.name << ": " << stats.processing.count() << " buffers" << std::endl;
+    print_histogram("latência na entrada", stats.latency_in);
+    print_histogram("latência na saída", stats.latency_out);
+    print_histogram("jitter na saída", stats.jitter);
+    print_histogram("processamento", stats.processing);
+}
+
+// kill -USR1 <pid> pede as estatísticas; Ctrl+C encerra o pipeline e imprime as finais
+static volatile std::sig_atomic_t dump_requested = 0;
+static volatile std::sig_atomic_t stop_requested = 0;
+
+inline void on_signal(int signal) {
+    if (signal == SIGUSR1) {
+        dump_requested = 1;
+    } else {
+        stop_requested = 1;
+    }
+}
+
+#endif
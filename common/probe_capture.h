@@ -0,0 +1,153 @@
+#ifndef COMMON_PROBE_CAPTURE_H
+#define COMMON_PROBE_CAPTURE_H
+
+// Captura de buffers por probes de pad com gravação em outra thread, compartilhada pelos exemplos 6 e 7
+
+#include <gst/gst.h>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <semaphore.h>
+
+// Fila circular lock-free de um produtor e um consumidor: a thread de streaming do GStreamer
+// empurra referências de buffers e a thread de gravação as retira, sem que nenhuma bloqueie a outra
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity deve ser potência de 2");
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    // Produtor: retorna false se a fila estiver cheia
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: retorna false se a fila estiver vazia
+    bool pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = slots[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T slots[Capacity];
+    alignas(64) std::atomic<size_t> head; // Índices em cache lines separadas para os dois lados não disputarem a mesma linha
+    alignas(64) std::atomic<size_t> tail;
+};
+
+// Acorda a thread de gravação. O probe sinaliza a cada buffer posto na fila: sem_post não bloqueia,
+// não aloca e não disputa lock com a thread de gravação, que dorme em sem_wait enquanto não há
+// nada pendente. Sinais a mais só fazem a thread encontrar as filas vazias e voltar a dormir.
+class WriterWakeup {
+public:
+    WriterWakeup() { sem_init(&semaphore, 0, 0); }
+    ~WriterWakeup() { sem_destroy(&semaphore); }
+
+    void signal() { sem_post(&semaphore); }
+
+    void wait() {
+        while (sem_wait(&semaphore) != 0 && errno == EINTR) {
+        }
+    }
+
+    WriterWakeup(const WriterWakeup&) = delete;
+    WriterWakeup& operator=(const WriterWakeup&) = delete;
+
+private:
+    sem_t semaphore;
+};
+
+// Um ponto de captura: a fila alimentada pelo probe do pad e o arquivo em que ela é gravada
+struct Capture {
+    const char *label;
+    std::ofstream file;
+    SpscRing<GstBuffer*, 256> ring;
+    std::atomic<unsigned long> dropped; // Buffers descartados com a fila cheia
+    WriterWakeup &wakeup;               // Compartilhado pelas capturas da mesma thread de gravação
+
+    Capture(const char *label, const char *path, WriterWakeup &wakeup)
+        : label(label), file(path, std::ios::binary), dropped(0), wakeup(wakeup) {}
+};
+
+// Callback para capturar os buffers. Roda na thread de streaming, então só guarda uma referência
+// do buffer na fila: nada de E/S, alocação ou lock que atrase o áudio. Com a fila cheia, o buffer
+// é descartado da captura (nunca do pipeline).
+inline GstPadProbeReturn buffer_probe_callback(GstPad *pad, GstPadProbeInfo *info, gpointer user_data) {
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    if (!buffer) return GST_PAD_PROBE_OK;
+
+    Capture *capture = static_cast<Capture*>(user_data);
+    gst_buffer_ref(buffer);
+    if (capture->ring.push(buffer)) {
+        capture->wakeup.signal();
+    } else {
+        gst_buffer_unref(buffer);
+        capture->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+// Descarrega a fila de uma captura no arquivo e no console; retorna quantos buffers foram gravados
+inline size_t drain_capture(Capture &capture) {
+    size_t count = 0;
+    GstBuffer *buffer;
+    while (capture.ring.pop(buffer)) {
+        GstMapInfo map;
+        if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+            std::cout << capture.label << " - Tamanho do buffer: " << map.size << " bytes\n";
+
+            // Exibir os primeiros 10 bytes para depuração
+            std::cout << capture.label << " - Dados: ";
+            for (gsize i = 0; i < map.size && i < 10; i++) {
+                std::cout << (int) map.data[i] << " ";
+            }
+            std::cout << "\n";
+
+            capture.file.write(reinterpret_cast<const char*>(map.data), map.size);
+            gst_buffer_unmap(buffer, &map);
+        }
+        gst_buffer_unref(buffer);
+        count++;
+    }
+    return count;
+}
+
+// Thread de gravação das duas capturas: esvazia as filas em lotes e dorme até o próximo sinal do
+// probe. Para encerrar, "capturando" vira false e a thread é acordada uma última vez: ela grava o
+// que restou nas filas e termina.
+inline void writer_thread(Capture &original, Capture &processada, const std::atomic<bool> &capturando, WriterWakeup &wakeup) {
+    while (true) {
+        bool running = capturando.load(std::memory_order_acquire);
+        size_t written = drain_capture(original) + drain_capture(processada);
+        if (written > 0) {
+            std::cout << std::flush;
+        } else if (!running) {
+            break;
+        } else {
+            wakeup.wait();
+        }
+    }
+}
+
+// Ctrl+C encerra o pipeline pelo caminho normal (sem perder o que está nas filas e no ofstream)
+static volatile std::sig_atomic_t stop_requested = 0;
+
+inline void on_signal(int) {
+    stop_requested = 1;
+}
+
+#endif
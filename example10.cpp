@@ -2,152 +2,225 @@
 #include <vector>
 #include <cmath>
 #include <sndfile.h>
-#include <fftw3.h>
 #include <complex>
-#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <string>
 #include <mpg123.h>
 
-#define PI 3.14159265358979323846
-
-// Converter MP3 para WAV usando mpg123
-bool convertMP3ToWAV(const std::string& mp3_file, const std::string& wav_file) {
-    mpg123_handle *mh;
-    int err;
-    if ((mh = mpg123_new(nullptr, &err)) == nullptr) {
-        std::cerr << "Erro ao inicializar mpg123!" << std::endl;
-        return false;
-    }
+// FFT, IFFT e recorte de espectro (com o cache de planos FFTW) da libfreqcomp
+#include "freqcomp/filter.h"
+#include "freqcomp/spectrum.h"
 
-    if (mpg123_open(mh, mp3_file.c_str()) != MPG123_OK) {
-        std::cerr << "Erro ao abrir arquivo MP3!" << std::endl;
-        return false;
-    }
+// Fonte de áudio WAV/MP3 em memória, comum aos exemplos 9, 10 e 12
+#include "common/audio_source.h"
 
-    long rate;
-    int channels, encoding;
-    mpg123_getformat(mh, &rate, &channels, &encoding);
+#define PI 3.14159265358979323846
 
-    std::vector<short> buffer(4096);
-    SNDFILE *outfile;
-    SF_INFO sfinfo = {0};
-    sfinfo.samplerate = rate;
-    sfinfo.channels = channels;
-    sfinfo.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+// Reamostragem espectral por quadros (STFT com overlap-add).
+// Cada quadro de frame_in amostras é janelado, transformado, tem o espectro cortado (ou completado
+// com zeros) para frame_out = frame_in * L / M bins e volta ao tempo já na taxa de destino. Como
+// cada quadro emite menos amostras do que recebe, a memória e o tamanho das FFTs ficam limitados
+// ao quadro, qualquer que seja a duração do arquivo.
+class STFTResampler {
+public:
+    STFTResampler(int original_rate, int target_rate, int frame_size, int hop_size)
+        : emitted(0), input_count(0), output_limit(-1) {
+        int g = freqcomp::gcd(original_rate, target_rate);
+        L = target_rate / g;
+        M = original_rate / g;
+
+        // O salto de entrada precisa ser múltiplo de M para que o de saída seja inteiro;
+        // o quadro é um múltiplo inteiro (>= 2) do salto para a soma das janelas ser constante
+        int overlap = std::max(2, (frame_size + hop_size / 2) / hop_size);
+        hop_in = std::max(1, (hop_size + M / 2) / M) * M;
+        frame_in = overlap * hop_in;
+        hop_out = hop_in / M * L;
+        frame_out = overlap * hop_out;
+
+        // Raiz da janela de Hann (periódica) na análise e na síntese; o produto é uma Hann,
+        // cuja soma com salto frame / overlap vale overlap / 2
+        analysis_window = sqrt_hann(frame_in);
+        synthesis_window = sqrt_hann(frame_out);
+        for (double& w : synthesis_window) {
+            w *= 2.0 / overlap;
+        }
 
-    outfile = sf_open(wav_file.c_str(), SFM_WRITE, &sfinfo);
-    if (!outfile) {
-        std::cerr << "Erro ao criar arquivo WAV!" << std::endl;
-        return false;
+        time_in = fftw_alloc_real(frame_in);
+        spectrum_in = fftw_alloc_complex(frame_in / 2 + 1);
+        spectrum_out = fftw_alloc_complex(frame_out / 2 + 1);
+        time_out = fftw_alloc_real(frame_out);
+        forward = freqcomp::FFTPlanCache::instance().r2c(frame_in, time_in, spectrum_in);
+        backward = freqcomp::FFTPlanCache::instance().c2r(frame_out, spectrum_out, time_out);
+
+        // Zeros antes do início para a primeira amostra já ter a soma completa das janelas;
+        // as frame_out - hop_out saídas correspondentes são descartadas
+        pending.assign(frame_in - hop_in, 0.0);
+        accumulator.assign(frame_out, 0.0);
+        skip = frame_out - hop_out;
     }
 
-    size_t bytes_read;
-    while (mpg123_read(mh, reinterpret_cast<unsigned char*>(buffer.data()), buffer.size() * sizeof(short), &bytes_read) == MPG123_OK) {
-        sf_write_short(outfile, buffer.data(), bytes_read / sizeof(short));
+    ~STFTResampler() {
+        fftw_free(time_in);
+        fftw_free(spectrum_in);
+        fftw_free(spectrum_out);
+        fftw_free(time_out);
     }
 
-    sf_close(outfile);
-    mpg123_close(mh);
-    mpg123_delete(mh);
+    STFTResampler(const STFTResampler&) = delete;
+    STFTResampler& operator=(const STFTResampler&) = delete;
 
-    return true;
-}
+    int input_frame() const { return frame_in; }
+    int input_hop() const { return hop_in; }
+    int output_frame() const { return frame_out; }
 
-// Aplicação da FFT para análise de frequência
-std::vector<std::complex<double>> computeFFT(const std::vector<double>& signal) {
-    int N = signal.size();
-    if (N < 512) {
-        std::cerr << "Erro: Sinal muito curto para FFT!" << std::endl;
-        return {};
+    // Processa "count" amostras e acrescenta em output as amostras já prontas na taxa de destino
+    void process(const double* input, int count, std::vector<double>& output) {
+        input_count += count;
+        pending.insert(pending.end(), input, input + count);
+        consume_frames(output);
     }
 
-    fftw_complex *in, *out;
-    fftw_plan p;
-
-    in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-
-    for (int i = 0; i < N; i++) {
-        in[i][0] = signal[i];
-        in[i][1] = 0.0;
+    // Completa os últimos quadros com zeros e entrega o restante, até ceil(entrada * L / M) amostras
+    void flush(std::vector<double>& output) {
+        output_limit = (input_count * L + M - 1) / M;
+        std::vector<double> zeros(hop_in, 0.0);
+        while (emitted < output_limit) {
+            pending.insert(pending.end(), zeros.begin(), zeros.end());
+            consume_frames(output);
+        }
     }
 
-    p = fftw_plan_dft_1d(N, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
-    fftw_execute(p);
-
-    std::vector<std::complex<double>> spectrum(N);
-    for (int i = 0; i < N; i++) {
-        spectrum[i] = std::complex<double>(out[i][0], out[i][1]);
+private:
+    static std::vector<double> sqrt_hann(int size) {
+        std::vector<double> window(size);
+        for (int i = 0; i < size; i++) {
+            window[i] = sqrt(0.5 - 0.5 * cos(2 * PI * i / size));
+        }
+        return window;
     }
 
-    fftw_destroy_plan(p);
-    fftw_free(in);
-    fftw_free(out);
-
-    return spectrum;
-}
-
-// Função para salvar FFT no arquivo
-void saveFFTtoFile(const std::vector<std::complex<double>>& spectrum, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file) {
-        std::cerr << "Erro ao abrir " << filename << " para escrita!" << std::endl;
-        return;
+    void consume_frames(std::vector<double>& output) {
+        size_t start = 0;
+        while (pending.size() - start >= (size_t) frame_in) {
+            process_frame(pending.data() + start, output);
+            start += hop_in;
+        }
+        pending.erase(pending.begin(), pending.begin() + start);
     }
 
-    for (const auto& val : spectrum) {
-        file << std::abs(val) << "\n";  // Escrevendo magnitude da FFT
-    }
-    
-    file.close();
-    std::cout << "FFT salva em: " << filename << std::endl;
-}
+    void process_frame(const double* frame, std::vector<double>& output) {
+        for (int i = 0; i < frame_in; i++) {
+            time_in[i] = frame[i] * analysis_window[i];
+        }
+        fftw_execute_dft_r2c(forward, time_in, spectrum_in);
+
+        // Mantém os bins abaixo da menor frequência de Nyquist; o fator 1/frame_in normaliza a IFFT
+        // e preserva a amplitude apesar da mudança de tamanho
+        int kept = std::min(frame_in, frame_out) / 2;
+        int bins_out = frame_out / 2 + 1;
+        for (int i = 0; i < bins_out; i++) {
+            spectrum_out[i][0] = i < kept ? spectrum_in[i][0] / frame_in : 0.0;
+            spectrum_out[i][1] = i < kept ? spectrum_in[i][1] / frame_in : 0.0;
+        }
+        fftw_execute_dft_c2r(backward, spectrum_out, time_out);
 
-// Redução de frequência pelo corte de espectro
-std::vector<std::complex<double>> reduceFrequency(const std::vector<std::complex<double>>& spectrum, int original_rate, int target_rate) {
-    int N = spectrum.size();
-    int cutoff = (target_rate * N) / (2 * original_rate);
-    std::vector<std::complex<double>> new_spectrum(N, std::complex<double>(0, 0));
+        for (int i = 0; i < frame_out; i++) {
+            accumulator[i] += time_out[i] * synthesis_window[i];
+        }
 
-    for (int i = 0; i < cutoff; i++) {
-        new_spectrum[i] = spectrum[i];
-        new_spectrum[N - i - 1] = spectrum[N - i - 1];
+        // As primeiras hop_out amostras não recebem mais contribuições
+        for (int i = 0; i < hop_out; i++) {
+            if (skip > 0) {
+                skip--;
+            } else if (output_limit < 0 || emitted < output_limit) {
+                output.push_back(accumulator[i]);
+                emitted++;
+            }
+        }
+        std::copy(accumulator.begin() + hop_out, accumulator.end(), accumulator.begin());
+        std::fill(accumulator.end() - hop_out, accumulator.end(), 0.0);
     }
 
-    return new_spectrum;
-}
-
-// Aplicação da IFFT para reconstruir o sinal
-std::vector<double> computeIFFT(const std::vector<std::complex<double>>& spectrum) {
-    int N = spectrum.size();
-    fftw_complex *in, *out;
-    fftw_plan p;
-
-    in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-
-    for (int i = 0; i < N; i++) {
-        in[i][0] = spectrum[i].real();
-        in[i][1] = spectrum[i].imag();
+    int L, M;
+    int frame_in, hop_in, frame_out, hop_out;
+    std::vector<double> analysis_window;
+    std::vector<double> synthesis_window;
+    std::vector<double> pending;     // Entrada ainda não consumida por um quadro completo
+    std::vector<double> accumulator; // Soma (overlap-add) dos quadros já sintetizados
+    int skip;
+    long long emitted;
+    long long input_count;
+    long long output_limit;
+
+    double* time_in;
+    fftw_complex* spectrum_in;
+    fftw_complex* spectrum_out;
+    double* time_out;
+    fftw_plan forward;
+    fftw_plan backward;
+};
+
+// Reamostra o arquivo inteiro por STFT, lendo e gravando em blocos (memória limitada ao quadro)
+bool process_stft(AudioSource& source, const std::string& output_file, int target_rate, int frame_size, int hop_size) {
+    SF_INFO sfinfo = source.format();
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = target_rate;
+    SNDFILE* outfile = sf_open(output_file.c_str(), SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        return false;
     }
 
-    p = fftw_plan_dft_1d(N, in, out, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fftw_execute(p);
-
-    std::vector<double> signal(N);
-    for (int i = 0; i < N; i++) {
-        signal[i] = out[i][0] / N;
+    // Um reamostrador por canal
+    int channels = sfinfo.channels;
+    std::vector<std::unique_ptr<STFTResampler>> resamplers;
+    for (int c = 0; c < channels; c++) {
+        resamplers.emplace_back(new STFTResampler(sfinfo.samplerate, target_rate, frame_size, hop_size));
     }
+    std::cout << "STFT: quadro " << resamplers[0]->input_frame() << " -> " << resamplers[0]->output_frame()
+              << " amostras, salto " << resamplers[0]->input_hop() << std::endl;
+
+    const int block_frames = 8192;
+    std::vector<double> input_block(block_frames * channels);
+    std::vector<double> channel_input(block_frames);
+    std::vector<std::vector<double>> channel_output(channels);
+    std::vector<double> output_block;
+
+    bool done = false;
+    while (!done) {
+        sf_count_t frames_read = source.read(input_block.data(), block_frames);
+        done = frames_read <= 0;
+        for (int c = 0; c < channels; c++) {
+            channel_output[c].clear();
+            if (done) {
+                resamplers[c]->flush(channel_output[c]);
+                continue;
+            }
+            for (sf_count_t i = 0; i < frames_read; i++) {
+                channel_input[i] = input_block[i * channels + c];
+            }
+            resamplers[c]->process(channel_input.data(), frames_read, channel_output[c]);
+        }
 
-    fftw_destroy_plan(p);
-    fftw_free(in);
-    fftw_free(out);
+        // Todos os canais emitem o mesmo número de amostras por bloco
+        int produced = channel_output[0].size();
+        output_block.resize(produced * channels);
+        for (int c = 0; c < channels; c++) {
+            for (int i = 0; i < produced; i++) {
+                output_block[i * channels + c] = channel_output[c][i];
+            }
+        }
+        sf_writef_double(outfile, output_block.data(), produced);
+    }
 
-    return signal;
+    sf_close(outfile);
+    return true;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 4) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo_entrada.mp3 ou .wav> <frequencia_destino_Hz> <arquivo_saida.wav>\n";
+    if (argc < 4 || argc > 6) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_entrada.mp3 ou .wav> <frequencia_destino_Hz> <arquivo_saida.wav> [tamanho_quadro [salto]]\n";
         return 1;
     }
 
@@ -155,49 +228,84 @@ int main(int argc, char* argv[]) {
     int target_frequency = std::stoi(argv[2]);
     std::string output_file = argv[3];
 
-    std::string temp_wav = "media/temp_input.wav";
+    // Planos FFTW ajustados em execuções anteriores
+    freqcomp::load_fft_wisdom();
 
-    // Se for MP3, converter para WAV
-    if (input_file.substr(input_file.find_last_of(".") + 1) == "mp3") {
-        if (!convertMP3ToWAV(input_file, temp_wav)) {
-            std::cerr << "Erro ao converter MP3 para WAV!" << std::endl;
+    // WAV lido com libsndfile; MP3 decodificado direto na memória, sem arquivo temporário
+    mpg123_init();
+    AudioSource source;
+    if (!source.open(input_file)) {
+        return 1;
+    }
+
+    // Modo STFT: quadros com overlap-add, memória limitada independentemente da duração
+    if (argc >= 5) {
+        int frame_size = std::stoi(argv[4]);
+        int hop_size = argc == 6 ? std::stoi(argv[5]) : frame_size / 2;
+        // Salto zero dividiria por zero; maior que o quadro deixaria amostras fora de todos os quadros
+        if (hop_size < 1 || hop_size > frame_size) {
+            std::cerr << "Erro: o salto precisa estar entre 1 e o tamanho do quadro (" << frame_size << ")" << std::endl;
+            return 1;
+        }
+        if (!process_stft(source, output_file, target_frequency, frame_size, hop_size)) {
             return 1;
         }
-        input_file = temp_wav;
+        freqcomp::save_fft_wisdom();
+        std::cout << "Processamento concluído! Arquivo salvo: " << output_file << std::endl;
+        return 0;
     }
 
     // Processamento do áudio
-    SF_INFO sfinfo;
-    SNDFILE* infile = sf_open(input_file.c_str(), SFM_READ, &sfinfo);
-    if (!infile) {
-        std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
-        return 1;
-    }
-
+    SF_INFO sfinfo = source.format();
     int sample_rate = sfinfo.samplerate;
-    int num_samples = sfinfo.frames;
-    std::vector<double> samples(num_samples);
-    sf_read_double(infile, samples.data(), num_samples);
-    sf_close(infile);
+    int num_channels = sfinfo.channels;
+
+    // Ler todos os canais (quadros intercalados) e separar um vetor por canal
+    std::vector<double> frames = source.read_all();
+    int num_samples = frames.size() / num_channels;
+    std::vector<std::vector<double>> channels = freqcomp::deinterleave(frames, num_channels);
+
+    // Decimação espectral: IFFT já no tamanho correspondente à taxa de destino
+    int output_size = (int) (((long long) num_samples * target_frequency + sample_rate / 2) / sample_rate);
+    std::vector<std::vector<double>> processed(num_channels);
+    for (int c = 0; c < num_channels; c++) {
+        std::vector<std::complex<double>> original_fft = freqcomp::computeFFT(channels[c]);
+        if (original_fft.empty()) {
+            return 1;
+        }
 
-    std::vector<std::complex<double>> original_fft = computeFFT(samples);
-    saveFFTtoFile(original_fft, "media/fft_original.dat");
+        std::vector<std::complex<double>> filtered_fft = freqcomp::reduceFrequency(original_fft, sample_rate, target_frequency);
 
-    std::vector<std::complex<double>> filtered_fft = reduceFrequency(original_fft, sample_rate, target_frequency);
-    saveFFTtoFile(filtered_fft, "media/fft_processed.dat");
+        // Espectros do primeiro canal para análise no Python
+        if (c == 0) {
+            freqcomp::saveFFTtoFile(original_fft, num_samples, "media/fft_original.dat");
+            freqcomp::saveFFTtoFile(filtered_fft, num_samples, "media/fft_processed.dat");
+        }
 
-    std::vector<double> processed_signal = computeIFFT(filtered_fft);
+        std::vector<std::complex<double>> decimated_fft = freqcomp::cropSpectrum(filtered_fft, num_samples, output_size);
+        processed[c] = freqcomp::computeIFFT(decimated_fft, output_size);
+    }
+    std::vector<double> processed_signal = freqcomp::interleave(processed);
 
     SF_INFO out_sfinfo = sfinfo;
     out_sfinfo.samplerate = target_frequency;
-    out_sfinfo.frames = processed_signal.size();
+    out_sfinfo.frames = output_size;
     SNDFILE* outfile = sf_open(output_file.c_str(), SFM_WRITE, &out_sfinfo);
-    sf_write_double(outfile, processed_signal.data(), processed_signal.size());
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        return 1;
+    }
+    sf_writef_double(outfile, processed_signal.data(), output_size);
     sf_close(outfile);
 
+    freqcomp::save_fft_wisdom();
+
     std::cout << "Processamento concluído! Arquivo salvo: " << output_file << std::endl;
     return 0;
 }
 
 // Run:
-// g++ -o example10 example10.cpp -lsndfile -lfftw3 -lmpg123 -lm -O2
\ No newline at end of file
+// cmake -S . -B build && cmake --build build
+// (ou, com a biblioteca já compilada: g++ -o example10 example10.cpp -Iinclude -Lbuild -lfreqcomp -lsndfile -lfftw3 -lmpg123 -lm -O2)
+// ./example10 media/audio.wav 16000 media/audio_output.wav              (FFT do arquivo inteiro)
+// ./example10 media/audio.wav 16000 media/audio_output.wav 2048 1024    (STFT, quadro 2048 e salto 1024)
\ No newline at end of file
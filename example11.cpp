@@ -0,0 +1,365 @@
+// Filtragem FIR longa com decimação por convolução rápida (overlap-save polifásico com FFTW)
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <sndfile.h>
+#include <fftw3.h>
+
+// Projeto do filtro, decimador direto (núcleos SIMD) e cache de planos FFTW da libfreqcomp
+#include "freqcomp/decimator.h"
+#include "freqcomp/filter.h"
+#include "freqcomp/spectrum.h"
+
+// Decimador FIR em fluxo contínuo por overlap-save polifásico: calcula só as saídas mantidas.
+// Com o filtro h dividido em "factor" fases h_p[j] = h[j * factor + p] e a entrada em
+// x_p[n] = x[n * factor - p], a saída decimada é y[m] = soma sobre p de (h_p * x_p)[m], isto é,
+// "factor" convoluções na taxa de saída. Cada uma é feita por FFT, os espectros são somados e uma
+// única IFFT por bloco gera as saídas: nada é calculado na taxa de entrada para ser descartado.
+// A saída m corresponde à entrada m * factor, como em freqcomp::Decimator (linha de atraso zerada).
+class FftDecimator {
+public:
+    FftDecimator(const std::vector<double>& coefficients, int factor, int channels)
+        : factor(factor), channels(channels) {
+        int filter_size = coefficients.size();
+        phase_length = (filter_size + factor - 1) / factor;
+
+        // FFT de tamanho potência de 2, cerca de 4x a fase: cada bloco gera fft_size - phase_length + 1 saídas
+        fft_size = 64;
+        while (fft_size < 4 * phase_length) {
+            fft_size *= 2;
+        }
+        block_outputs = fft_size - phase_length + 1;
+        bins = fft_size / 2 + 1;
+        time_buffer = fftw_alloc_real(fft_size);
+        freq_buffer = fftw_alloc_complex(bins);
+        sum_buffer = fftw_alloc_complex(bins);
+
+        // Planos do cache compartilhado (com o wisdom salvo, não são medidos de novo a cada execução)
+        forward = freqcomp::FFTPlanCache::instance().r2c(fft_size, time_buffer, freq_buffer);
+        backward = freqcomp::FFTPlanCache::instance().c2r(fft_size, sum_buffer, time_buffer);
+
+        // Resposta em frequência de cada fase, já com a normalização 1/N da IFFT
+        phase_spectra.resize((size_t) factor * bins * 2);
+        for (int p = 0; p < factor; p++) {
+            std::fill(time_buffer, time_buffer + fft_size, 0.0);
+            for (int j = 0; j < phase_length && j * factor + p < filter_size; j++) {
+                time_buffer[j] = coefficients[j * factor + p];
+            }
+            fftw_execute_dft_r2c(forward, time_buffer, freq_buffer);
+            for (int i = 0; i < bins; i++) {
+                phase_spectra[((size_t) p * bins + i) * 2] = freq_buffer[i][0] / fft_size;
+                phase_spectra[((size_t) p * bins + i) * 2 + 1] = freq_buffer[i][1] / fft_size;
+            }
+        }
+        reset();
+    }
+
+    ~FftDecimator() {
+        fftw_free(time_buffer);
+        fftw_free(freq_buffer);
+        fftw_free(sum_buffer);
+    }
+
+    FftDecimator(const FftDecimator&) = delete;
+    FftDecimator& operator=(const FftDecimator&) = delete;
+
+    // Volta ao estado inicial: antes do início o sinal é nulo
+    void reset() {
+        history_start = -(long long) phase_length * factor;
+        history.assign((size_t) -history_start * channels, 0.0);
+        received = 0;
+        next_output = 0;
+    }
+
+    int max_output(int count) const {
+        return count / factor + 1;
+    }
+
+    // Filtra e decima quadros intercalados; retorna quantos quadros de saída foram gravados
+    int process(const double* input, int count, double* output) {
+        history.insert(history.end(), input, input + (size_t) count * channels);
+        received += count;
+
+        // Saídas cuja amostra mais nova (m * factor) já chegou
+        long long last = received > 0 ? (received - 1) / factor : -1;
+        int produced = 0;
+        while (next_output <= last) {
+            int outputs = (int) std::min<long long>(block_outputs, last - next_output + 1);
+            for (int c = 0; c < channels; c++) {
+                process_block(c, outputs, output + (size_t) produced * channels);
+            }
+            next_output += outputs;
+            produced += outputs;
+        }
+
+        // Descarta as amostras que nenhuma saída futura vai usar: a mais antiga é a da fase
+        // factor - 1 no início da janela do próximo bloco
+        long long first_needed = (next_output - phase_length + 1) * factor - (factor - 1);
+        if (first_needed > history_start) {
+            history.erase(history.begin(), history.begin() + (size_t) (first_needed - history_start) * channels);
+            history_start = first_needed;
+        }
+        return produced;
+    }
+
+private:
+    // Amostra de entrada n (contada desde reset) do canal c
+    double sample(long long n, int c) const {
+        return history[(size_t) (n - history_start) * channels + c];
+    }
+
+    // Overlap-save de "outputs" saídas a partir de next_output: para cada fase, [histórico | novas |
+    // zeros] -> FFT -> produto com a fase do filtro, acumulado; uma IFFT no fim. As primeiras
+    // phase_length - 1 posições têm aliasing circular e são descartadas.
+    void process_block(int c, int outputs, double* output) {
+        long long first = next_output - phase_length + 1; // Índice (na taxa de saída) da posição 0 do bloco
+        int used = phase_length - 1 + outputs;
+        std::fill(&sum_buffer[0][0], &sum_buffer[0][0] + 2 * bins, 0.0);
+        for (int p = 0; p < factor; p++) {
+            for (int i = 0; i < used; i++) {
+                time_buffer[i] = sample((first + i) * factor - p, c);
+            }
+            std::fill(time_buffer + used, time_buffer + fft_size, 0.0);
+            fftw_execute_dft_r2c(forward, time_buffer, freq_buffer);
+
+            const double* h = &phase_spectra[(size_t) p * bins * 2];
+            for (int i = 0; i < bins; i++) {
+                sum_buffer[i][0] += freq_buffer[i][0] * h[2 * i] - freq_buffer[i][1] * h[2 * i + 1];
+                sum_buffer[i][1] += freq_buffer[i][0] * h[2 * i + 1] + freq_buffer[i][1] * h[2 * i];
+            }
+        }
+        fftw_execute_dft_c2r(backward, sum_buffer, time_buffer);
+        for (int j = 0; j < outputs; j++) {
+            output[(size_t) j * channels + c] = time_buffer[phase_length - 1 + j];
+        }
+    }
+
+    int factor;
+    int channels;
+    int phase_length;  // Coeficientes por fase: ceil(filter_size / factor)
+    int fft_size;
+    int block_outputs; // Saídas por bloco de FFT
+    int bins;
+    double* time_buffer;
+    fftw_complex* freq_buffer;
+    fftw_complex* sum_buffer;
+    std::vector<double> phase_spectra; // Bin i da fase p em phase_spectra[2 * (p * bins + i)] (real, imaginário)
+    fftw_plan forward;
+    fftw_plan backward;
+
+    std::vector<double> history; // Quadros a partir de history_start (intercalados)
+    long long history_start;     // Índice do primeiro quadro de history (negativo = zeros iniciais)
+    long long received;          // Quadros recebidos desde reset
+    long long next_output;       // Índice da próxima saída
+};
+
+// Decima o sinal inteiro com blocos de entrada de tamanhos irregulares
+template <typename Engine>
+std::vector<double> decimate_all(Engine& engine, const std::vector<double>& input, int channels) {
+    long long frames = input.size() / channels;
+    std::vector<double> output((size_t) engine.max_output((int) frames) * channels);
+    const int block_sizes[] = {8192, 1, 37, 1000, 5};
+    long long offset = 0;
+    int produced = 0;
+    for (int b = 0; offset < frames; b = (b + 1) % 5) {
+        int count = (int) std::min<long long>(block_sizes[b], frames - offset);
+        produced += engine.process(input.data() + offset * channels, count, output.data() + (size_t) produced * channels);
+        offset += count;
+    }
+    output.resize((size_t) produced * channels);
+    return output;
+}
+
+std::vector<double> noise_signal(size_t size) {
+    std::vector<double> signal(size);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    for (double& x : signal) {
+        x = noise(rng);
+    }
+    return signal;
+}
+
+// Menor tempo de "repetitions" execuções, depois de uma de aquecimento (caches, planos do FFTW e
+// frequência da CPU): o mínimo é o que menos sofre com interrupções e outros processos
+template <typename Function>
+std::chrono::steady_clock::duration best_time(Function run, int repetitions) {
+    run();
+    std::chrono::steady_clock::duration best = std::chrono::steady_clock::duration::max();
+    for (int r = 0; r < repetitions; r++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::steady_clock::now() - start);
+    }
+    return best;
+}
+
+// Mede, para um fator de decimação, o menor número de coeficientes a partir do qual o overlap-save
+// polifásico é mais rápido que o decimador direto da biblioteca. O resultado fica salvo para as
+// próximas execuções, então cada tamanho é medido com aquecimento e várias repetições.
+int measure_fft_crossover(int factor) {
+    const int repetitions = 5;
+    const int signal_size = 1 << 16;
+    std::vector<double> signal = noise_signal(signal_size);
+    std::vector<double> output(signal_size / factor + 1);
+
+    for (int filter_size = 16; filter_size <= 4096; filter_size *= 2) {
+        std::vector<double> coefficients = freqcomp::generate_fir_coefficients(filter_size - 1, 0.45 / factor, 2.0);
+        freqcomp::Decimator<double> direct(coefficients, factor);
+        FftDecimator fft(coefficients, factor, 1);
+
+        auto direct_time = best_time([&]() { direct.process(signal.data(), signal_size, output.data()); }, repetitions);
+        auto fft_time = best_time([&]() { fft.process(signal.data(), signal_size, output.data()); }, repetitions);
+        if (fft_time < direct_time) {
+            return filter_size;
+        }
+    }
+    // A FFT não compensou em nenhum dos tamanhos medidos
+    return std::numeric_limits<int>::max();
+}
+
+// Cruzamentos já medidos, por fator, guardados como o wisdom do FFTW: "fator coeficientes" por linha
+const char* crossover_file = "media/fft_cruzamento.txt";
+
+std::map<int, int> load_crossovers() {
+    std::map<int, int> crossovers;
+    std::ifstream file(crossover_file);
+    int factor, crossover;
+    while (file >> factor >> crossover) {
+        crossovers[factor] = crossover;
+    }
+    return crossovers;
+}
+
+// Cruzamento do fator: do arquivo ou, na primeira vez, medido e salvo para as próximas execuções
+int fft_crossover(int factor) {
+    std::map<int, int> crossovers = load_crossovers();
+    std::map<int, int>::iterator it = crossovers.find(factor);
+    if (it != crossovers.end()) {
+        return it->second;
+    }
+    int crossover = measure_fft_crossover(factor);
+    crossovers[factor] = crossover;
+    std::ofstream file(crossover_file);
+    for (it = crossovers.begin(); it != crossovers.end(); ++it) {
+        file << it->first << " " << it->second << "\n";
+    }
+    if (!file) {
+        std::cerr << "Aviso: não foi possível salvar o cruzamento em " << crossover_file << std::endl;
+    }
+    return crossover;
+}
+
+// Compara o overlap-save polifásico com o decimador direto (a FFT não é exata: erro de arredondamento)
+bool verify_fft_decimator() {
+    bool ok = true;
+    for (int channels : {1, 2}) {
+        std::vector<double> signal = noise_signal((size_t) 50000 * channels);
+        for (int filter_order : {254, 1022}) {
+            for (int factor : {2, 3, 8}) {
+                std::vector<double> coefficients = freqcomp::generate_fir_coefficients(filter_order, 0.45 / factor, 2.0);
+                freqcomp::Decimator<double> direct(coefficients, factor, channels);
+                FftDecimator fft(coefficients, factor, channels);
+                std::vector<double> expected = decimate_all(direct, signal, channels);
+                std::vector<double> output = decimate_all(fft, signal, channels);
+
+                double max_error = 0.0;
+                for (size_t i = 0; i < expected.size() && i < output.size(); i++) {
+                    max_error = std::max(max_error, std::fabs(expected[i] - output[i]));
+                }
+                bool close = output.size() == expected.size() && max_error < 1e-12;
+                std::cout << channels << " canal(is), " << coefficients.size() << " coeficientes, fator " << factor
+                          << ": erro máximo " << max_error << (close ? "" : " — DIFERENTE") << std::endl;
+                ok = ok && close;
+            }
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    freqcomp::load_fft_wisdom();
+    if (argc == 2 && std::string(argv[1]) == "--verificar") {
+        return verify_fft_decimator() ? 0 : 1;
+    }
+    if (argc != 5 && argc != 6) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_entrada.wav> <ordem_filtro> <fator_decimacao> <arquivo_saida.wav> [cruzamento]\n";
+        std::cerr << "     " << argv[0] << " --verificar\n";
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    int filter_order = std::stoi(argv[2]);
+    int downsample_factor = std::stoi(argv[3]);
+    const char* output_file = argv[4];
+
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
+        return 1;
+    }
+
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = sfinfo.samplerate / downsample_factor;
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        sf_close(infile);
+        return 1;
+    }
+
+    // Filtro anti-aliasing com corte um pouco abaixo da nova frequência de Nyquist
+    double cutoff_frequency = 0.45 * sfinfo.samplerate / downsample_factor;
+    std::vector<double> fir_coeffs = freqcomp::generate_fir_coefficients(filter_order, cutoff_frequency, sfinfo.samplerate);
+
+    // Decimador direto para filtros curtos, overlap-save a partir do cruzamento (argumento, arquivo
+    // ou medido uma única vez por fator)
+    int crossover = argc == 6 ? std::stoi(argv[5]) : fft_crossover(downsample_factor);
+    bool use_fft = (int) fir_coeffs.size() >= crossover;
+    if (crossover == std::numeric_limits<int>::max()) {
+        std::cout << "Cruzamento direto/FFT: a FFT não compensou até 4096 coeficientes";
+    } else {
+        std::cout << "Cruzamento direto/FFT: " << crossover << " coeficientes";
+    }
+    std::cout << "; usando " << (use_fft ? "overlap-save polifásico (FFT)" : "decimador direto")
+              << " para " << fir_coeffs.size() << std::endl;
+
+    int channels = sfinfo.channels;
+    freqcomp::Decimator<double> direct(fir_coeffs, downsample_factor, channels);
+    std::unique_ptr<FftDecimator> fft(use_fft ? new FftDecimator(fir_coeffs, downsample_factor, channels) : nullptr);
+
+    const int block_frames = 8192;
+    std::vector<double> input_block((size_t) block_frames * channels);
+    std::vector<double> output_block((size_t) direct.max_output(block_frames) * channels);
+
+    sf_count_t frames_read;
+    while ((frames_read = sf_readf_double(infile, input_block.data(), block_frames)) > 0) {
+        int produced = fft ? fft->process(input_block.data(), frames_read, output_block.data())
+                           : direct.process(input_block.data(), frames_read, output_block.data());
+        sf_writef_double(outfile, output_block.data(), produced);
+    }
+
+    sf_close(infile);
+    sf_close(outfile);
+    freqcomp::save_fft_wisdom();
+
+    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example11 media/audio.wav 1023 3 media/audio_output_fft.wav        (cruzamento medido uma vez e salvo)
+// ./build/example11 media/audio.wav 1023 3 media/audio_output_fft.wav 256    (cruzamento informado)
+// ./build/example11 --verificar   (overlap-save polifásico contra o decimador direto)
@@ -0,0 +1,330 @@
+// Conversão em lote: filtra e decima todos os arquivos de um diretório (ou de uma lista)
+// em um único processo, com um pool de threads e roubo de tarefas (work stealing)
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <climits>
+#include <cstdlib>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <mpg123.h>
+#include <sndfile.h>
+
+// Banco de coeficientes e decimador em fluxo contínuo (núcleos SIMD) da libfreqcomp
+#include "freqcomp/coefficient_bank.h"
+#include "freqcomp/decimator.h"
+
+// Fonte de áudio WAV/MP3 em memória, comum aos exemplos 9, 10 e 12
+#include "common/audio_source.h"
+
+// Fila de tarefas de uma thread. A dona retira pelo fim; as outras roubam pelo início,
+// pegando as tarefas mais antigas e disputando o mínimo possível com a dona.
+class WorkStealingQueue {
+public:
+    void push(int task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+
+    bool pop(int& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<int> tasks;
+};
+
+// Estado de cada thread, reaproveitado de um arquivo para o outro: blocos de entrada e saída e um
+// decimador (filtro já calculado e linha de atraso) para cada formato de entrada
+struct WorkerBuffers {
+    std::vector<double> input_block;
+    std::vector<double> output_block;
+    std::map<std::pair<int, int>, freqcomp::Decimator<double>> decimators; // Por (taxa de amostragem, canais)
+    int files = 0;
+    int stolen = 0;
+};
+
+struct BatchSettings {
+    std::string output_dir;
+    int filter_order;
+    int downsample_factor;
+    double cutoff_frequency; // Em Hz; 0 usa 0,45 * taxa de saída
+};
+
+const int block_frames = 8192;
+
+bool has_extension(const std::string& path, const std::string& extension) {
+    if (path.size() < extension.size()) {
+        return false;
+    }
+    std::string tail = path.substr(path.size() - extension.size());
+    std::transform(tail.begin(), tail.end(), tail.begin(), ::tolower);
+    return tail == extension;
+}
+
+// Nome do arquivo de saída: o nome da entrada no diretório de saída, com .wav acrescentado quando a
+// entrada não é WAV (a.mp3 -> a.mp3.wav), para não coincidir com a.wav do mesmo diretório
+std::string output_path(const std::string& input, const std::string& output_dir) {
+    size_t slash = input.find_last_of('/');
+    std::string name = slash == std::string::npos ? input : input.substr(slash + 1);
+    if (!has_extension(name, ".wav")) {
+        name += ".wav";
+    }
+    return output_dir + "/" + name;
+}
+
+// Caminho absoluto sem links simbólicos nem "..": o do próprio arquivo, se ele existe, ou o do
+// diretório seguido do nome (saídas que ainda não foram criadas)
+std::string canonical_path(const std::string& path) {
+    char resolved[PATH_MAX];
+    if (realpath(path.c_str(), resolved)) {
+        return resolved;
+    }
+    size_t slash = path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (realpath(dir.c_str(), resolved)) {
+        return std::string(resolved) + "/" + name;
+    }
+    return path;
+}
+
+// Entradas de diretórios diferentes podem ter o mesmo nome (em um manifesto): duas threads
+// gravariam o mesmo arquivo ao mesmo tempo. Uma saída também não pode ser uma das entradas (por
+// exemplo, com o diretório de saída igual ao de entrada): ela seria truncada enquanto outra thread
+// ainda a lê. Retorna false se alguma saída se repete ou coincide com uma entrada.
+bool check_output_collisions(const std::vector<std::string>& inputs, const std::string& output_dir) {
+    std::map<std::string, std::string> sources;
+    for (const std::string& input : inputs) {
+        sources[canonical_path(input)] = input;
+    }
+
+    std::map<std::string, std::string> owners;
+    bool unique = true;
+    for (const std::string& input : inputs) {
+        std::string output = canonical_path(output_path(input, output_dir));
+        std::map<std::string, std::string>::iterator source = sources.find(output);
+        if (source != sources.end()) {
+            std::cerr << "Erro: a saída de " << input << " sobrescreveria a entrada " << source->second << std::endl;
+            unique = false;
+            continue;
+        }
+        std::map<std::string, std::string>::iterator it = owners.find(output);
+        if (it != owners.end()) {
+            std::cerr << "Erro: " << it->second << " e " << input << " seriam salvos no mesmo arquivo " << output << std::endl;
+            unique = false;
+        } else {
+            owners[output] = input;
+        }
+    }
+    return unique;
+}
+
+// Lista os arquivos .wav e .mp3 de um diretório ou as linhas de um arquivo de manifesto
+std::vector<std::string> collect_inputs(const std::string& source) {
+    std::vector<std::string> inputs;
+    struct stat info;
+    if (stat(source.c_str(), &info) != 0) {
+        std::cerr << "Erro ao acessar " << source << std::endl;
+        return inputs;
+    }
+
+    if (S_ISDIR(info.st_mode)) {
+        DIR* dir = opendir(source.c_str());
+        if (!dir) {
+            std::cerr << "Erro ao abrir o diretório " << source << std::endl;
+            return inputs;
+        }
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (has_extension(name, ".wav") || has_extension(name, ".mp3")) {
+                inputs.push_back(source + "/" + name);
+            }
+        }
+        closedir(dir);
+        std::sort(inputs.begin(), inputs.end());
+    } else {
+        // Manifesto: um caminho por linha; linhas vazias e iniciadas por # são ignoradas
+        std::ifstream manifest(source);
+        std::string line;
+        while (std::getline(manifest, line)) {
+            if (!line.empty() && line[0] != '#') {
+                inputs.push_back(line);
+            }
+        }
+    }
+    return inputs;
+}
+
+// Pipeline completo de um arquivo: decodificação, filtro FIR, decimação e escrita, em blocos
+bool process_file(const std::string& input, const BatchSettings& settings, WorkerBuffers& buffers) {
+    AudioSource source;
+    if (!source.open(input)) {
+        return false;
+    }
+    SF_INFO sfinfo = source.format();
+
+    int factor = settings.downsample_factor;
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = sfinfo.samplerate / factor;
+    std::string output_file = output_path(input, settings.output_dir);
+    SNDFILE* outfile = sf_open(output_file.c_str(), SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao salvar arquivo WAV: " << output_file << std::endl;
+        return false;
+    }
+
+    // Decimador criado uma vez por formato em cada thread; nos arquivos seguintes ele só volta ao
+    // estado inicial. O filtro vem do banco compartilhado: as threads não projetam o mesmo filtro de novo.
+    int channels = sfinfo.channels;
+    std::pair<int, int> format(sfinfo.samplerate, channels);
+    std::map<std::pair<int, int>, freqcomp::Decimator<double>>::iterator it = buffers.decimators.find(format);
+    if (it == buffers.decimators.end()) {
+        double cutoff_frequency = settings.cutoff_frequency > 0 ? settings.cutoff_frequency : 0.45 * sfinfo.samplerate / factor;
+        const std::vector<double>& coefficients = freqcomp::cached_fir_coefficients(settings.filter_order, cutoff_frequency, sfinfo.samplerate);
+        it = buffers.decimators.insert(std::make_pair(format, freqcomp::Decimator<double>(coefficients, factor, channels))).first;
+    }
+    freqcomp::Decimator<double>& decimator = it->second;
+    decimator.reset();
+
+    // Os vetores só crescem: depois dos primeiros arquivos não há mais alocação
+    buffers.input_block.resize((size_t) block_frames * channels);
+    buffers.output_block.resize((size_t) decimator.max_output(block_frames) * channels);
+
+    sf_count_t frames_read;
+    while ((frames_read = source.read(buffers.input_block.data(), block_frames)) > 0) {
+        int produced = decimator.process(buffers.input_block.data(), frames_read, buffers.output_block.data());
+        sf_writef_double(outfile, buffers.output_block.data(), produced);
+    }
+
+    sf_close(outfile);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 5 || argc > 7) {
+        std::cerr << "Uso: " << argv[0] << " <diretorio_ou_manifesto> <diretorio_saida> <ordem_filtro> <fator_decimacao> [threads] [corte_Hz]\n";
+        return 1;
+    }
+
+    BatchSettings settings;
+    settings.output_dir = argv[2];
+    int thread_count = 0;
+    try {
+        settings.filter_order = std::stoi(argv[3]);
+        settings.downsample_factor = std::stoi(argv[4]);
+        thread_count = argc >= 6 ? std::stoi(argv[5]) : 0;
+        settings.cutoff_frequency = argc == 7 ? std::stod(argv[6]) : 0.0;
+    } catch (const std::exception&) {
+        std::cerr << "Erro: ordem, fator, threads e corte precisam ser números" << std::endl;
+        return 1;
+    }
+    if (settings.filter_order < 0 || settings.downsample_factor < 1 || thread_count < 0 || settings.cutoff_frequency < 0) {
+        std::cerr << "Erro: a ordem do filtro, as threads e o corte não podem ser negativos, e o fator precisa ser pelo menos 1" << std::endl;
+        return 1;
+    }
+    if (thread_count == 0) {
+        thread_count = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+
+    std::vector<std::string> inputs = collect_inputs(argv[1]);
+    if (inputs.empty()) {
+        std::cerr << "Nenhum arquivo .wav ou .mp3 encontrado em " << argv[1] << std::endl;
+        return 1;
+    }
+    if (!check_output_collisions(inputs, settings.output_dir)) {
+        return 1;
+    }
+    mkdir(settings.output_dir.c_str(), 0755);
+    mpg123_init();
+
+    // Distribuição inicial em rodízio; quem esvaziar a própria fila rouba das demais
+    std::vector<std::unique_ptr<WorkStealingQueue>> queues;
+    std::vector<WorkerBuffers> buffers(thread_count);
+    for (int t = 0; t < thread_count; t++) {
+        queues.emplace_back(new WorkStealingQueue());
+    }
+    for (size_t i = 0; i < inputs.size(); i++) {
+        queues[i % thread_count]->push(i);
+    }
+
+    std::atomic<int> failures(0);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count; t++) {
+        workers.emplace_back([&, t]() {
+            WorkerBuffers& own = buffers[t];
+            int task;
+            for (;;) {
+                bool found = queues[t]->pop(task);
+                // Nenhuma tarefa nova é criada durante a execução: se todas as filas
+                // estão vazias, o trabalho acabou
+                for (int i = 1; !found && i < thread_count; i++) {
+                    found = queues[(t + i) % thread_count]->steal(task);
+                    own.stolen += found;
+                }
+                if (!found) {
+                    break;
+                }
+                // Um erro em um arquivo (exceção do decodificador ou do decimador) não pode derrubar o
+                // processo: fora do try, a exceção chegaria ao fim da thread e chamaria std::terminate
+                bool ok = false;
+                try {
+                    ok = process_file(inputs[task], settings, own);
+                } catch (const std::exception& e) {
+                    std::cerr << "Erro ao processar " << inputs[task] << ": " << e.what() << std::endl;
+                }
+                if (!ok) {
+                    failures++;
+                }
+                own.files++;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (int t = 0; t < thread_count; t++) {
+        std::cout << "Thread " << t << ": " << buffers[t].files << " arquivos (" << buffers[t].stolen << " roubados)" << std::endl;
+    }
+    std::cout << "Processamento concluído! " << inputs.size() - failures << " de " << inputs.size()
+              << " arquivos em " << seconds << " s, salvos em " << settings.output_dir << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example12 media media/lote 64 3              (todos os .wav/.mp3 de media/, uma thread por núcleo)
+// ./build/example12 lista.txt media/lote 64 3 8        (um caminho por linha, 8 threads)
+// ./build/example12 media media/lote 31 2 0 4000       (corte em 4000 Hz, os mesmos parâmetros do example2)
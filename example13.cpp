@@ -0,0 +1,456 @@
+// Filtro FIR e decimação em ponto fixo (Q15/Q31), com entrada e saída em PCM de 16 bits.
+// As amostras nunca passam por double: int16 ocupa 4x menos memória e banda que double.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // Intrínsecos SSE2/AVX2
+#endif
+#include <sndfile.h>
+
+// Projeto do filtro e decimador polifásico em double (referência) da libfreqcomp; a detecção da CPU
+// dos núcleos também é a dela
+#include "freqcomp/filter.h"
+#include "freqcomp/kernels.h"
+
+// Converte o acumulador para int16: arredonda, desloca "shift" bits e satura em [-32768, 32767]
+inline int16_t saturate_q(int64_t acc, int shift) {
+    int64_t value = (acc + ((int64_t) 1 << (shift - 1))) >> shift;
+    return (int16_t) std::max<int64_t>(-32768, std::min<int64_t>(32767, value));
+}
+
+// Núcleos de decimação em ponto fixo. Os coeficientes chegam invertidos e completados com zeros no
+// início até um múltiplo de 16, então cada saída é um produto escalar contíguo:
+//   output[m] = soma de coefficients[j] * input[m * factor - (size - 1) + j]
+// "input" aponta para a amostra mais nova da primeira saída. Aritmética inteira é exata, então todas
+// as variantes dão o mesmo resultado bit a bit.
+
+// Q15: coeficientes de 16 bits, produtos acumulados em 32 bits (sem estouro: ver FixedPointDecimator)
+void fir_q15_scalar(const int16_t* coefficients, int size, const int16_t* input, int factor, int shift, int16_t* output, int count) {
+    for (int m = 0; m < count; m++) {
+        const int16_t* x = input + (long) m * factor - (size - 1);
+        int32_t acc = 0;
+        for (int j = 0; j < size; j++) {
+            acc += (int32_t) coefficients[j] * x[j];
+        }
+        output[m] = saturate_q(acc, shift);
+    }
+}
+
+// Q31: coeficientes de 32 bits, produtos acumulados em 64 bits (filtros longos ou muito seletivos)
+void fir_q31_scalar(const int32_t* coefficients, int size, const int16_t* input, int factor, int shift, int16_t* output, int count) {
+    for (int m = 0; m < count; m++) {
+        const int16_t* x = input + (long) m * factor - (size - 1);
+        int64_t acc = 0;
+        for (int j = 0; j < size; j++) {
+            acc += (int64_t) coefficients[j] * x[j];
+        }
+        output[m] = saturate_q(acc, shift);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Soma horizontal de 4 acumuladores de 4 x int32: retorna [soma(a0), soma(a1), soma(a2), soma(a3)]
+__attribute__((target("sse2")))
+inline __m128i horizontal_sum4(__m128i a0, __m128i a1, __m128i a2, __m128i a3) {
+    __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(a0, a1), _mm_unpackhi_epi32(a0, a1));
+    __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(a2, a3), _mm_unpackhi_epi32(a2, a3));
+    return _mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+}
+
+// Arredonda, desloca e grava 4 saídas; _mm_packs_epi32 satura em int16. Como em saturate_q, o
+// arredondamento é somado em 64 bits: em 32, uma soma perto de INT32_MAX estouraria. O resultado
+// deslocado cabe em int32, então o deslocamento lógico de 64 bits dá os mesmos 32 bits baixos do aritmético.
+__attribute__((target("sse2")))
+inline void store_q15x4(__m128i sums, int shift, int16_t* output) {
+    __m128i sign = _mm_srai_epi32(sums, 31);
+    __m128i low = _mm_unpacklo_epi32(sums, sign);  // sums[0], sums[1] em int64
+    __m128i high = _mm_unpackhi_epi32(sums, sign); // sums[2], sums[3] em int64
+    __m128i round = _mm_set1_epi64x((int64_t) 1 << (shift - 1));
+    __m128i count = _mm_cvtsi32_si128(shift);
+    low = _mm_srl_epi64(_mm_add_epi64(low, round), count);
+    high = _mm_srl_epi64(_mm_add_epi64(high, round), count);
+    // Junta os 32 bits baixos de cada int64: [low0, low1, high0, high1]
+    sums = _mm_unpacklo_epi64(_mm_shuffle_epi32(low, _MM_SHUFFLE(3, 1, 2, 0)), _mm_shuffle_epi32(high, _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_packs_epi32(sums, sums));
+}
+
+// _mm_madd_epi16 multiplica pares de int16 e soma cada par em int32; 4 saídas por iteração
+__attribute__((target("sse2")))
+void fir_q15_sse2(const int16_t* coefficients, int size, const int16_t* input, int factor, int shift, int16_t* output, int count) {
+    int m = 0;
+    for (; m + 4 <= count; m += 4) {
+        const int16_t* x = input + (long) m * factor - (size - 1);
+        __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+        __m128i acc2 = _mm_setzero_si128(), acc3 = _mm_setzero_si128();
+        for (int j = 0; j < size; j += 8) {
+            __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients + j));
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + j)), h));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + factor + j)), h));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + 2 * factor + j)), h));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + 3 * factor + j)), h));
+        }
+        store_q15x4(horizontal_sum4(acc0, acc1, acc2, acc3), shift, output + m);
+    }
+    fir_q15_scalar(coefficients, size, input + (long) m * factor, factor, shift, output + m, count - m);
+}
+
+__attribute__((target("avx2")))
+inline __m128i fold_256(__m256i v) {
+    return _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+__attribute__((target("avx2")))
+void fir_q15_avx2(const int16_t* coefficients, int size, const int16_t* input, int factor, int shift, int16_t* output, int count) {
+    int m = 0;
+    for (; m + 4 <= count; m += 4) {
+        const int16_t* x = input + (long) m * factor - (size - 1);
+        __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256(), acc3 = _mm256_setzero_si256();
+        for (int j = 0; j < size; j += 16) {
+            __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(coefficients + j));
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j)), h));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + factor + j)), h));
+            acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + 2 * factor + j)), h));
+            acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + 3 * factor + j)), h));
+        }
+        store_q15x4(horizontal_sum4(fold_256(acc0), fold_256(acc1), fold_256(acc2), fold_256(acc3)), shift, output + m);
+    }
+    fir_q15_scalar(coefficients, size, input + (long) m * factor, factor, shift, output + m, count - m);
+}
+
+// Q31: as amostras são estendidas para int32 e _mm256_mul_epi32 multiplica as posições pares em
+// 64 bits; as ímpares entram depois de deslocadas para a metade baixa de cada par
+__attribute__((target("avx2")))
+void fir_q31_avx2(const int32_t* coefficients, int size, const int16_t* input, int factor, int shift, int16_t* output, int count) {
+    for (int m = 0; m < count; m++) {
+        const int16_t* x = input + (long) m * factor - (size - 1);
+        __m256i acc = _mm256_setzero_si256();
+        for (int j = 0; j < size; j += 8) {
+            __m256i xv = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + j)));
+            __m256i hv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(coefficients + j));
+            acc = _mm256_add_epi64(acc, _mm256_mul_epi32(xv, hv));
+            acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(xv, 32), _mm256_srli_epi64(hv, 32)));
+        }
+        int64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        output[m] = saturate_q(lanes[0] + lanes[1] + lanes[2] + lanes[3], shift);
+    }
+}
+#endif
+
+typedef void (*FirQ15Kernel)(const int16_t*, int, const int16_t*, int, int, int16_t*, int);
+typedef void (*FirQ31Kernel)(const int32_t*, int, const int16_t*, int, int, int16_t*, int);
+
+// Variantes dos núcleos, da mais larga para a mais estreita, com os nomes das variantes da
+// libfreqcomp (freqcomp::fir_kernel_variants) do mesmo conjunto de instruções
+struct FixedKernelVariant {
+    const char* name;
+    FirQ15Kernel q15;
+    FirQ31Kernel q31;
+};
+
+const FixedKernelVariant fixed_kernel_variants[] = {
+#if defined(__x86_64__) || defined(__i386__)
+    {"avx2", fir_q15_avx2, fir_q31_avx2},
+    {"sse2", fir_q15_sse2, fir_q31_scalar},
+#endif
+    {"escalar", fir_q15_scalar, fir_q31_scalar},
+};
+
+const FixedKernelVariant& scalar_fixed_kernel() {
+    return fixed_kernel_variants[sizeof(fixed_kernel_variants) / sizeof(fixed_kernel_variants[0]) - 1];
+}
+
+// Variante em ponto fixo de uma variante da biblioteca, ou nullptr se não houver (AVX-512)
+const FixedKernelVariant* find_fixed_kernel(const freqcomp::FirKernelVariant& library) {
+    for (const FixedKernelVariant& variant : fixed_kernel_variants) {
+        if (std::strcmp(variant.name, library.name) == 0) {
+            return &variant;
+        }
+    }
+    return nullptr;
+}
+
+// O CPUID fica com a libfreqcomp: parte da variante que ela escolheu (selected_fir_kernel) e desce
+// para as mais estreitas até achar uma com versão em ponto fixo
+const FixedKernelVariant& select_fixed_kernel() {
+    const std::vector<freqcomp::FirKernelVariant>& library = freqcomp::fir_kernel_variants();
+    for (size_t i = &freqcomp::selected_fir_kernel() - library.data(); i < library.size(); i++) {
+        const FixedKernelVariant* variant = find_fixed_kernel(library[i]);
+        if (variant && library[i].supported()) {
+            return *variant;
+        }
+    }
+    return scalar_fixed_kernel();
+}
+
+// Suportada pela CPU quando a variante de mesmo nome da biblioteca é
+bool fixed_kernel_supported(const FixedKernelVariant& variant) {
+    freqcomp::selected_fir_kernel(); // A biblioteca inicializa a detecção da CPU na primeira chamada
+    for (const freqcomp::FirKernelVariant& library : freqcomp::fir_kernel_variants()) {
+        if (std::strcmp(variant.name, library.name) == 0) {
+            return library.supported();
+        }
+    }
+    return false;
+}
+
+const FixedKernelVariant& fixed_kernel = select_fixed_kernel();
+
+// Decimador FIR em ponto fixo e em fluxo contínuo, para quadros PCM de 16 bits intercalados.
+// Em Q15 os coeficientes são quantizados com 15 bits fracionários; se a soma dos seus módulos
+// permitir estouro do acumulador de 32 bits, a escala cai um bit por vez (Q14, Q13... até Q1), o que
+// mantém toda soma parcial exata. Se nem Q1 couber, lança std::invalid_argument (use Q31). Em Q31 os coeficientes têm 31 bits fracionários e o acumulador 64.
+class FixedPointDecimator {
+public:
+    FixedPointDecimator(const std::vector<double>& coefficients, int factor, int channels, bool q31, const FixedKernelVariant& kernel = fixed_kernel)
+        : factor(factor), channels(channels), q31(q31), kernel(kernel), history(channels) {
+        // Coeficientes invertidos, com zeros no início até um múltiplo de 16
+        int filter_size = coefficients.size();
+        size = (filter_size + 15) / 16 * 16;
+        std::vector<double> reversed(size, 0.0);
+        for (int k = 0; k < filter_size; k++) {
+            reversed[size - 1 - k] = coefficients[k];
+        }
+
+        if (q31) {
+            shift = 31;
+            coefficients_q31.resize(size);
+            for (int j = 0; j < size; j++) {
+                coefficients_q31[j] = (int32_t) std::max(-2147483648.0, std::min(2147483647.0, std::round(reversed[j] * 2147483648.0)));
+            }
+        } else {
+            for (shift = 15;; shift--) {
+                coefficients_q15.assign(size, 0);
+                int64_t magnitude = 0;
+                for (int j = 0; j < size; j++) {
+                    coefficients_q15[j] = (int16_t) std::max(-32768.0, std::min(32767.0, std::round(std::ldexp(reversed[j], shift))));
+                    magnitude += std::abs((int) coefficients_q15[j]);
+                }
+                // |acumulador| <= magnitude * 32768 precisa caber em int32
+                if (magnitude * 32768 <= INT32_MAX) {
+                    break;
+                }
+                if (shift == 1) {
+                    throw std::invalid_argument("FixedPointDecimator: coeficientes grandes demais para Q15 (use q31)");
+                }
+            }
+        }
+        reset();
+    }
+
+    // Volta ao estado inicial (linha de atraso zerada, como um sinal nulo antes do início)
+    void reset() {
+        for (std::vector<int16_t>& line : history) {
+            line.assign(size - 1, 0);
+        }
+        next_output = size - 1;
+    }
+
+    int max_output(int count) const {
+        return count / factor + 1;
+    }
+
+    // Bits fracionários dos coeficientes quantizados
+    int fraction_bits() const {
+        return shift;
+    }
+
+    // Filtra e decima um bloco de quadros intercalados; retorna quantos quadros foram gerados
+    int process(const int16_t* input, int count, int16_t* output) {
+        int produced = 0;
+        for (int c = 0; c < channels; c++) {
+            std::vector<int16_t>& line = history[c];
+            for (int i = 0; i < count; i++) {
+                line.push_back(input[(size_t) i * channels + c]);
+            }
+            int length = line.size();
+            produced = next_output < length ? (length - 1 - next_output) / factor + 1 : 0;
+
+            channel_output.resize(produced);
+            if (q31) {
+                kernel.q31(coefficients_q31.data(), size, line.data() + next_output, factor, shift, channel_output.data(), produced);
+            } else {
+                kernel.q15(coefficients_q15.data(), size, line.data() + next_output, factor, shift, channel_output.data(), produced);
+            }
+            for (int m = 0; m < produced; m++) {
+                output[(size_t) m * channels + c] = channel_output[m];
+            }
+        }
+
+        // Descarta as amostras que nenhuma saída futura vai usar
+        int length = history[0].size();
+        next_output += produced * factor;
+        int discard = std::min(length, next_output - (size - 1));
+        for (std::vector<int16_t>& line : history) {
+            line.erase(line.begin(), line.begin() + discard);
+        }
+        next_output -= discard;
+        return produced;
+    }
+
+private:
+    int factor;
+    int channels;
+    bool q31;
+    const FixedKernelVariant& kernel;
+    int size;  // Coeficientes com o preenchimento
+    int shift; // Bits fracionários dos coeficientes
+    std::vector<int16_t> coefficients_q15;
+    std::vector<int32_t> coefficients_q31;
+    std::vector<std::vector<int16_t>> history; // Linha de atraso de cada canal
+    int next_output;                           // Posição (em history) da próxima saída
+    std::vector<int16_t> channel_output;
+};
+
+// Decima um sinal inteiro de um canal em blocos de tamanhos irregulares
+std::vector<int16_t> decimate_all(FixedPointDecimator& decimator, const std::vector<int16_t>& input) {
+    std::vector<int16_t> output(decimator.max_output(input.size()));
+    const int block_sizes[] = {4096, 1, 37, 1000, 5};
+    size_t offset = 0;
+    int produced = 0;
+    for (int b = 0; offset < input.size(); b = (b + 1) % 5) {
+        int count = std::min<size_t>(block_sizes[b], input.size() - offset);
+        produced += decimator.process(input.data() + offset, count, output.data() + produced);
+        offset += count;
+    }
+    output.resize(produced);
+    return output;
+}
+
+// Confere que as variantes SIMD são idênticas à escalar e mede a relação sinal-ruído de Q15 e Q31
+// contra o mesmo filtro em double (primeiro canal do arquivo)
+bool verify_fixed_point(const char* input_file, int filter_order, int factor) {
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir arquivo WAV!" << std::endl;
+        return false;
+    }
+    std::vector<int16_t> interleaved((size_t) sfinfo.frames * sfinfo.channels);
+    sf_readf_short(infile, interleaved.data(), sfinfo.frames);
+    sf_close(infile);
+    std::vector<int16_t> input(sfinfo.frames);
+    for (sf_count_t i = 0; i < sfinfo.frames; i++) {
+        input[i] = interleaved[i * sfinfo.channels];
+    }
+
+    std::vector<double> coefficients = freqcomp::generate_fir_coefficients(filter_order, 0.45 * sfinfo.samplerate / factor, sfinfo.samplerate);
+
+    // Referência em double: y[m] = soma de h[k] * x[m * factor - k]
+    std::vector<double> reference = freqcomp::polyphase_decimate(std::vector<double>(input.begin(), input.end()), coefficients, factor);
+
+    std::cout << "Núcleo selecionado: " << fixed_kernel.name << std::endl;
+    bool identical = true;
+    for (bool q31 : {false, true}) {
+        const char* format = q31 ? "Q31" : "Q15";
+        FixedPointDecimator scalar(coefficients, factor, 1, q31, scalar_fixed_kernel());
+        std::vector<int16_t> expected = decimate_all(scalar, input);
+
+        for (const FixedKernelVariant& variant : fixed_kernel_variants) {
+            if (!fixed_kernel_supported(variant)) {
+                continue;
+            }
+            FixedPointDecimator decimator(coefficients, factor, 1, q31, variant);
+            bool same = decimate_all(decimator, input) == expected;
+            std::cout << format << ", núcleo " << variant.name << ": " << (same ? "idêntico" : "DIFERENTE") << std::endl;
+            identical = identical && same;
+        }
+
+        double signal = 0.0, noise = 0.0;
+        for (size_t m = 0; m < expected.size() && m < reference.size(); m++) {
+            double ideal = std::max(-32768.0, std::min(32767.0, reference[m]));
+            signal += ideal * ideal;
+            noise += (expected[m] - ideal) * (expected[m] - ideal);
+        }
+        std::cout << format << " (Q" << scalar.fraction_bits() << " nos coeficientes): SNR contra double = "
+                  << 10.0 * std::log10(signal / std::max(noise, 1e-30)) << " dB" << std::endl;
+    }
+    return identical;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::string(argv[1]) == "--verificar") {
+        try {
+            return verify_fixed_point(argv[2], 63, 3) ? 0 : 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "Erro ao quantizar os coeficientes: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (argc < 5 || argc > 6) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_entrada.wav> <ordem_filtro> <fator_decimacao> <arquivo_saida.wav> [q15|q31]\n";
+        std::cerr << "     " << argv[0] << " --verificar <arquivo_entrada.wav>\n";
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    int filter_order = std::stoi(argv[2]);
+    int downsample_factor = std::stoi(argv[3]);
+    const char* output_file = argv[4];
+    bool q31 = argc == 6 && std::string(argv[5]) == "q31";
+
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
+        return 1;
+    }
+
+    // Saída sempre em PCM de 16 bits
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = sfinfo.samplerate / downsample_factor;
+    out_sfinfo.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        sf_close(infile);
+        return 1;
+    }
+
+    // Filtro anti-aliasing com corte um pouco abaixo da nova frequência de Nyquist
+    double cutoff_frequency = 0.45 * sfinfo.samplerate / downsample_factor;
+    std::vector<double> fir_coeffs = freqcomp::generate_fir_coefficients(filter_order, cutoff_frequency, sfinfo.samplerate);
+    int channels = sfinfo.channels;
+    std::unique_ptr<FixedPointDecimator> decimator;
+    try {
+        decimator.reset(new FixedPointDecimator(fir_coeffs, downsample_factor, channels, q31));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Erro ao quantizar os coeficientes: " << e.what() << std::endl;
+        sf_close(infile);
+        sf_close(outfile);
+        return 1;
+    }
+    std::cout << "Núcleo " << fixed_kernel.name << ", coeficientes em Q" << decimator->fraction_bits() << std::endl;
+
+    const int block_frames = 4096;
+    std::vector<int16_t> input_block(block_frames * channels);
+    std::vector<int16_t> output_block(decimator->max_output(block_frames) * channels);
+
+    sf_count_t frames_read;
+    while ((frames_read = sf_readf_short(infile, input_block.data(), block_frames)) > 0) {
+        int produced = decimator->process(input_block.data(), frames_read, output_block.data());
+        sf_writef_short(outfile, output_block.data(), produced);
+    }
+
+    sf_close(infile);
+    sf_close(outfile);
+
+    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example13 media/audio.wav 63 3 media/audio_output_q15.wav
+// ./build/example13 media/audio.wav 255 3 media/audio_output_q31.wav q31
+// ./build/example13 --verificar media/audio.wav   (variantes SIMD idênticas à escalar e SNR contra double)
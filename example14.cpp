@@ -0,0 +1,484 @@
+// Motor de filtragem e decimação genérico no tipo da amostra (int16, float ou double), com versões
+// especializadas em tempo de compilação para número de coeficientes e fator de decimação fixos
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <sndfile.h>
+
+// Projeto do filtro e decimador em fluxo contínuo (versão genérica em float e double) da libfreqcomp
+#include "freqcomp/decimator.h"
+#include "freqcomp/filter.h"
+
+// A comparação bit a bit entre as versões especializada e genérica exige que multiplicação e soma
+// não sejam fundidas em FMA (o compilador poderia fazer isso só em uma delas)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+// Tipos usados para cada tipo de amostra: coeficiente, acumulador e conversões de entrada e saída.
+// Em ponto flutuante tudo fica no próprio tipo; int16 usa coeficientes Q15 e acumulador de 64 bits,
+// com arredondamento e saturação na saída.
+template <typename Sample>
+struct SampleTraits {
+    typedef Sample Coefficient;
+    typedef Sample Accumulator;
+    static Coefficient quantize(double h) { return Coefficient(h); }
+    static Sample finish(Accumulator acc) { return acc; }
+};
+
+template <>
+struct SampleTraits<int16_t> {
+    typedef int32_t Coefficient;
+    typedef int64_t Accumulator;
+    static Coefficient quantize(double h) { return (int32_t) std::lround(h * 32768.0); }
+    static int16_t finish(Accumulator acc) {
+        int64_t value = (acc + (1 << 14)) >> 15;
+        return (int16_t) std::max<int64_t>(-32768, std::min<int64_t>(32767, value));
+    }
+};
+
+// Desenrola o laço dos coeficientes quando o número deles é constante
+#if defined(__clang__)
+#define UNROLL_TAPS _Pragma("unroll")
+#elif defined(__GNUC__)
+#define UNROLL_TAPS _Pragma("GCC unroll 64")
+#else
+#define UNROLL_TAPS
+#endif
+
+// Núcleo de decimação sobre as componentes polifásicas do trecho de entrada: a saída m usa as amostras
+// h[m * factor + j], j = 0..taps-1 (da mais antiga para a mais nova, coeficientes invertidos), e
+// h[m * factor + j] = phases[j % factor][m + j / factor]. Os termos são somados da amostra mais nova
+// para a mais antiga, na mesma ordem de freqcomp::Decimator, para que as saídas sejam idênticas. Para cada coeficiente as saídas vizinhas
+// leem amostras contíguas, então o laço sobre um bloco de saídas vira SIMD. Com Taps e Factor
+// positivos o laço dos coeficientes é desenrolado e fase e deslocamento de cada um são constantes;
+// com 0 os valores vêm de taps/factor em tempo de execução.
+template <typename Sample, int Taps, int Factor>
+inline __attribute__((always_inline))
+void fir_decimate_block(const typename SampleTraits<Sample>::Coefficient* reversed, int taps, int factor,
+                        const Sample* const* phases, Sample* output, int count) {
+    typedef typename SampleTraits<Sample>::Accumulator Accumulator;
+    const int n_taps = Taps > 0 ? Taps : taps;
+    const int step = Factor > 0 ? Factor : factor;
+    const int block = 32; // Saídas calculadas juntas: o laço sobre elas vira SIMD
+    int m = 0;
+    for (; m + block <= count; m += block) {
+        Accumulator acc[block] = {};
+        UNROLL_TAPS
+        for (int j = n_taps - 1; j >= 0; j--) {
+            const Sample* x = phases[j % step] + j / step + m;
+            const Accumulator c = reversed[j];
+            for (int i = 0; i < block; i++) {
+                acc[i] += c * x[i];
+            }
+        }
+        for (int i = 0; i < block; i++) {
+            output[m + i] = SampleTraits<Sample>::finish(acc[i]);
+        }
+    }
+    for (; m < count; m++) {
+        Accumulator acc = 0;
+        for (int j = n_taps - 1; j >= 0; j--) {
+            acc += Accumulator(reversed[j]) * phases[j % step][j / step + m];
+        }
+        output[m] = SampleTraits<Sample>::finish(acc);
+    }
+}
+
+// Variantes do núcleo para a CPU: o mesmo corpo, vetorizado pelo compilador com AVX2 ou AVX-512
+// dentro de funções com atributo target. A variante é escolhida pelo CPUID (como em src/kernels.cpp),
+// então o binário roda em qualquer x86-64 sem -march=native.
+template <typename Sample>
+struct BlockKernel {
+    typedef void (*type)(const typename SampleTraits<Sample>::Coefficient*, int, int, const Sample* const*, Sample*, int);
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+template <typename Sample, int Taps, int Factor>
+__attribute__((target("avx2")))
+void fir_decimate_block_avx2(const typename SampleTraits<Sample>::Coefficient* reversed, int taps, int factor,
+                             const Sample* const* phases, Sample* output, int count) {
+    fir_decimate_block<Sample, Taps, Factor>(reversed, taps, factor, phases, output, count);
+}
+
+template <typename Sample, int Taps, int Factor>
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+void fir_decimate_block_avx512(const typename SampleTraits<Sample>::Coefficient* reversed, int taps, int factor,
+                               const Sample* const* phases, Sample* output, int count) {
+    fir_decimate_block<Sample, Taps, Factor>(reversed, taps, factor, phases, output, count);
+}
+#endif
+
+enum BlockIsa { ISA_BASE, ISA_AVX2, ISA_AVX512 };
+
+BlockIsa detect_block_isa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512vl")) {
+        return ISA_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return ISA_AVX2;
+    }
+#endif
+    return ISA_BASE;
+}
+
+const BlockIsa block_isa = detect_block_isa();
+
+const char* block_isa_name() {
+    switch (block_isa) {
+    case ISA_AVX512: return "avx512";
+    case ISA_AVX2: return "avx2";
+    default: return "base";
+    }
+}
+
+template <typename Sample, int Taps, int Factor>
+typename BlockKernel<Sample>::type select_block_kernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (block_isa == ISA_AVX512) {
+        return fir_decimate_block_avx512<Sample, Taps, Factor>;
+    }
+    if (block_isa == ISA_AVX2) {
+        return fir_decimate_block_avx2<Sample, Taps, Factor>;
+    }
+#endif
+    return fir_decimate_block<Sample, Taps, Factor>;
+}
+
+// Interface comum das versões especializadas e da genérica
+template <typename Sample>
+class Decimator {
+public:
+    virtual ~Decimator() {}
+    virtual void reset() = 0;
+    virtual int max_output(int count) const = 0;
+    // Filtra e decima um bloco de amostras; retorna quantas saídas foram gravadas em output
+    virtual int process(const Sample* input, int count, Sample* output) = 0;
+    virtual bool specialized() const = 0;
+};
+
+// Decimador FIR em fluxo contínuo de um canal. Taps = Factor = 0 é a versão genérica, com número de
+// coeficientes e fator definidos em tempo de execução.
+template <typename Sample, int Taps = 0, int Factor = 0>
+class FirDecimator : public Decimator<Sample> {
+public:
+    FirDecimator(const std::vector<double>& coefficients, int factor)
+        : taps(coefficients.size()), factor(factor), kernel(select_block_kernel<Sample, Taps, Factor>()),
+          reversed(coefficients.size()), phases(factor), phase_pointers(factor) {
+        for (int k = 0; k < taps; k++) {
+            reversed[taps - 1 - k] = SampleTraits<Sample>::quantize(coefficients[k]);
+        }
+        reset();
+    }
+
+    void reset() {
+        history.assign(taps - 1, Sample(0));
+        next_output = taps - 1;
+    }
+
+    int max_output(int count) const {
+        return count / factor + 1;
+    }
+
+    int process(const Sample* input, int count, Sample* output) {
+        history.insert(history.end(), input, input + count);
+        int size = history.size();
+        int produced = next_output < size ? (size - 1 - next_output) / factor + 1 : 0;
+
+        // Componentes polifásicas do trecho usado por este bloco, a partir da amostra mais antiga
+        // da primeira saída
+        int base = next_output - (taps - 1);
+        for (int p = 0; p < factor; p++) {
+            phases[p].resize(base + p < size ? (size - 1 - base - p) / factor + 1 : 0);
+            const Sample* source = history.data() + base + p;
+            for (size_t n = 0; n < phases[p].size(); n++) {
+                phases[p][n] = source[n * factor];
+            }
+            phase_pointers[p] = phases[p].data();
+        }
+        kernel(reversed.data(), taps, factor, phase_pointers.data(), output, produced);
+
+        // Descarta as amostras que nenhuma saída futura vai usar
+        next_output += produced * factor;
+        int discard = std::min(size, next_output - (taps - 1));
+        history.erase(history.begin(), history.begin() + discard);
+        next_output -= discard;
+        return produced;
+    }
+
+    bool specialized() const {
+        return Taps > 0;
+    }
+
+private:
+    int taps;
+    int factor;
+    typename BlockKernel<Sample>::type kernel;
+    std::vector<typename SampleTraits<Sample>::Coefficient> reversed;
+    std::vector<Sample> history; // Linha de atraso + bloco atual
+    int next_output;             // Posição (em history) da próxima saída
+    std::vector<std::vector<Sample>> phases; // Reaproveitadas entre blocos
+    std::vector<const Sample*> phase_pointers;
+};
+
+// Versão genérica em float e double: o decimador da libfreqcomp, com o núcleo SIMD escolhido pela CPU
+template <typename Sample>
+class LibraryDecimator : public Decimator<Sample> {
+public:
+    LibraryDecimator(const std::vector<double>& coefficients, int factor) : decimator(coefficients, factor) {}
+
+    void reset() {
+        decimator.reset();
+    }
+
+    int max_output(int count) const {
+        return decimator.max_output(count);
+    }
+
+    int process(const Sample* input, int count, Sample* output) {
+        return decimator.process(input, count, output);
+    }
+
+    bool specialized() const {
+        return false;
+    }
+
+private:
+    freqcomp::Decimator<Sample> decimator;
+};
+
+// Versão genérica de cada tipo; a biblioteca não tem decimador em int16, que usa FirDecimator
+template <typename Sample>
+Decimator<Sample>* make_generic(const std::vector<double>& coefficients, int factor) {
+    return new LibraryDecimator<Sample>(coefficients, factor);
+}
+
+template <>
+Decimator<int16_t>* make_generic<int16_t>(const std::vector<double>& coefficients, int factor) {
+    return new FirDecimator<int16_t>(coefficients, factor);
+}
+
+// Versões especializadas para um número de coeficientes fixo: fatores 2, 3 e 6
+template <typename Sample, int Taps>
+Decimator<Sample>* make_specialized(const std::vector<double>& coefficients, int factor) {
+    switch (factor) {
+    case 2: return new FirDecimator<Sample, Taps, 2>(coefficients, factor);
+    case 3: return new FirDecimator<Sample, Taps, 3>(coefficients, factor);
+    case 6: return new FirDecimator<Sample, Taps, 6>(coefficients, factor);
+    default: return nullptr;
+    }
+}
+
+// Versão especializada quando a configuração é comum e ela de fato ganha da genérica. Só em int16:
+// medido com --verificar, em float e double a especializada roda a 0,6x-1,1x da velocidade do
+// decimador da biblioteca (polifásico, núcleos SIMD), então ela não é escolhida automaticamente.
+template <typename Sample>
+struct PreferSpecialized {
+    static const bool value = false;
+};
+
+template <>
+struct PreferSpecialized<int16_t> {
+    static const bool value = true;
+};
+
+// Versão especializada para int16 em uma das configurações comuns (31 ou 32 coeficientes, isto é,
+// ordem 30 ou 31, com fator 2, 3 ou 6); a genérica nos demais casos
+template <typename Sample>
+Decimator<Sample>* make_specialized_for(const std::vector<double>& coefficients, int factor) {
+    if (coefficients.size() == 31) {
+        return make_specialized<Sample, 31>(coefficients, factor);
+    } else if (coefficients.size() == 32) {
+        return make_specialized<Sample, 32>(coefficients, factor);
+    }
+    return nullptr;
+}
+
+template <typename Sample>
+std::unique_ptr<Decimator<Sample>> make_decimator(const std::vector<double>& coefficients, int factor) {
+    Decimator<Sample>* decimator = PreferSpecialized<Sample>::value ? make_specialized_for<Sample>(coefficients, factor) : nullptr;
+    if (!decimator) {
+        decimator = make_generic<Sample>(coefficients, factor);
+    }
+    return std::unique_ptr<Decimator<Sample>>(decimator);
+}
+
+// Leitura e escrita de quadros no tipo usado pelo processamento
+sf_count_t read_frames(SNDFILE* file, int16_t* data, sf_count_t frames) { return sf_readf_short(file, data, frames); }
+sf_count_t read_frames(SNDFILE* file, float* data, sf_count_t frames) { return sf_readf_float(file, data, frames); }
+sf_count_t read_frames(SNDFILE* file, double* data, sf_count_t frames) { return sf_readf_double(file, data, frames); }
+sf_count_t write_frames(SNDFILE* file, const int16_t* data, sf_count_t frames) { return sf_writef_short(file, data, frames); }
+sf_count_t write_frames(SNDFILE* file, const float* data, sf_count_t frames) { return sf_writef_float(file, data, frames); }
+sf_count_t write_frames(SNDFILE* file, const double* data, sf_count_t frames) { return sf_writef_double(file, data, frames); }
+
+// Formato do arquivo de saída correspondente ao tipo da amostra
+template <typename Sample> int output_subformat();
+template <> int output_subformat<int16_t>() { return SF_FORMAT_PCM_16; }
+template <> int output_subformat<float>() { return SF_FORMAT_FLOAT; }
+template <> int output_subformat<double>() { return SF_FORMAT_DOUBLE; }
+
+// Processa um arquivo WAV em blocos, com um decimador por canal
+template <typename Sample>
+bool process_audio(const char* input_file, const char* output_file, int filter_order, int downsample_factor) {
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
+        return false;
+    }
+
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = sfinfo.samplerate / downsample_factor;
+    out_sfinfo.format = SF_FORMAT_WAV | output_subformat<Sample>();
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        sf_close(infile);
+        return false;
+    }
+
+    // Filtro anti-aliasing com corte um pouco abaixo da nova frequência de Nyquist
+    double cutoff_frequency = 0.45 * sfinfo.samplerate / downsample_factor;
+    std::vector<double> fir_coeffs = freqcomp::generate_fir_coefficients(filter_order, cutoff_frequency, sfinfo.samplerate);
+
+    int channels = sfinfo.channels;
+    std::vector<std::unique_ptr<Decimator<Sample>>> decimators;
+    for (int c = 0; c < channels; c++) {
+        decimators.push_back(make_decimator<Sample>(fir_coeffs, downsample_factor));
+    }
+    std::cout << "Versão " << (decimators[0]->specialized() ? "especializada" : "genérica") << " para "
+              << fir_coeffs.size() << " coeficientes e fator " << downsample_factor << " (núcleo " << block_isa_name() << ")" << std::endl;
+
+    const int block_frames = 4096;
+    std::vector<Sample> input_block(block_frames * channels);
+    std::vector<Sample> channel_input(block_frames);
+    std::vector<Sample> channel_output(decimators[0]->max_output(block_frames));
+    std::vector<Sample> output_block(channel_output.size() * channels);
+
+    sf_count_t frames_read;
+    while ((frames_read = read_frames(infile, input_block.data(), block_frames)) > 0) {
+        int produced = 0;
+        for (int c = 0; c < channels; c++) {
+            for (sf_count_t i = 0; i < frames_read; i++) {
+                channel_input[i] = input_block[i * channels + c];
+            }
+            produced = decimators[c]->process(channel_input.data(), frames_read, channel_output.data());
+            for (int i = 0; i < produced; i++) {
+                output_block[i * channels + c] = channel_output[i];
+            }
+        }
+        write_frames(outfile, output_block.data(), produced);
+    }
+
+    sf_close(infile);
+    sf_close(outfile);
+    return true;
+}
+
+// Decima o sinal inteiro em blocos de 4096 amostras e mede o tempo gasto
+template <typename Sample>
+std::vector<Sample> run_decimator(Decimator<Sample>& decimator, const std::vector<Sample>& input, double& seconds) {
+    std::vector<Sample> output(decimator.max_output(input.size()));
+    auto start = std::chrono::steady_clock::now();
+    int produced = 0;
+    for (size_t offset = 0; offset < input.size(); offset += 4096) {
+        int count = std::min<size_t>(4096, input.size() - offset);
+        produced += decimator.process(input.data() + offset, count, output.data() + produced);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    output.resize(produced);
+    return output;
+}
+
+// Compara cada versão especializada com a genérica (saída idêntica) e mostra o ganho de velocidade
+template <typename Sample>
+bool verify_specializations(const char* type_name, double scale) {
+    std::vector<Sample> input(1 << 20);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    for (Sample& x : input) {
+        x = Sample(noise(rng) * scale);
+    }
+
+    bool identical = true;
+    for (int filter_order : {30, 31}) {
+        for (int factor : {2, 3, 6}) {
+            std::vector<double> coefficients = freqcomp::generate_fir_coefficients(filter_order, 0.45 * 48000 / factor, 48000);
+            std::unique_ptr<Decimator<Sample>> specialized(make_specialized_for<Sample>(coefficients, factor));
+            std::unique_ptr<Decimator<Sample>> generic(make_generic<Sample>(coefficients, factor));
+
+            // Melhor de três execuções de cada, depois de uma de aquecimento
+            double specialized_seconds = 0, generic_seconds = 0;
+            bool same = true;
+            for (int run = 0; run < 4; run++) {
+                double s_time, g_time;
+                specialized->reset();
+                generic->reset();
+                same = same && run_decimator(*specialized, input, s_time) == run_decimator(*generic, input, g_time);
+                if (run == 1 || (run > 1 && s_time < specialized_seconds)) specialized_seconds = s_time;
+                if (run == 1 || (run > 1 && g_time < generic_seconds)) generic_seconds = g_time;
+            }
+            std::cout << type_name << ", " << coefficients.size() << " coeficientes, fator " << factor << ": "
+                      << (same ? "idêntico" : "DIFERENTE") << "; " << specialized_seconds * 1e9 / input.size()
+                      << " ns/amostra contra " << generic_seconds * 1e9 / input.size() << " da versão genérica ("
+                      << generic_seconds / specialized_seconds << "x; usada: "
+                      << (make_decimator<Sample>(coefficients, factor)->specialized() ? "especializada" : "genérica") << ")" << std::endl;
+            identical = identical && same && specialized->specialized();
+        }
+    }
+    return identical;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 && std::string(argv[1]) == "--verificar") {
+        std::cout << "Núcleo das versões especializadas: " << block_isa_name() << std::endl;
+        bool ok = verify_specializations<int16_t>("int16", 32767.0);
+        ok = verify_specializations<float>("float", 1.0) && ok;
+        ok = verify_specializations<double>("double", 1.0) && ok;
+        return ok ? 0 : 1;
+    }
+    if (argc < 5 || argc > 6) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_entrada.wav> <ordem_filtro> <fator_decimacao> <arquivo_saida.wav> [int16|float|double]\n";
+        std::cerr << "     " << argv[0] << " --verificar\n";
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    int filter_order = std::stoi(argv[2]);
+    int downsample_factor = std::stoi(argv[3]);
+    const char* output_file = argv[4];
+    std::string type = argc == 6 ? argv[5] : "double";
+
+    bool ok;
+    if (type == "int16") {
+        ok = process_audio<int16_t>(input_file, output_file, filter_order, downsample_factor);
+    } else if (type == "float") {
+        ok = process_audio<float>(input_file, output_file, filter_order, downsample_factor);
+    } else {
+        ok = process_audio<double>(input_file, output_file, filter_order, downsample_factor);
+    }
+    if (!ok) {
+        return 1;
+    }
+
+    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example14 media/audio.wav 31 2 media/audio_output.wav int16   (versão especializada: 32 coeficientes, fator 2)
+// ./build/example14 media/audio.wav 63 4 media/audio_output.wav         (versão genérica)
+// ./build/example14 --verificar   (especializadas idênticas à genérica, com o ganho de velocidade e a versão escolhida)
@@ -0,0 +1,288 @@
+// Planejador de decimação em múltiplos estágios: divide uma razão grande (48000 -> 160,
+// 44100 -> 8000) em estágios menores, usa filtros de meia banda (um coeficiente em cada dois é
+// zero) onde possível e informa o custo em multiplicações-acumulações (MACs) por amostra de saída.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <sndfile.h>
+
+// Projeto dos filtros, máximo divisor comum e (des)intercalação de canais da libfreqcomp
+#include "freqcomp/filter.h"
+
+#define PI 3.14159265358979323846
+
+// Largura de transição da janela de Hamming: cerca de 3.3 / N da taxa de amostragem (~53 dB de rejeição)
+const double hamming_transition = 3.3;
+
+// Um estágio da cascata: fator inteiro (up = 1) ou razão racional up/down no último estágio
+struct Stage {
+    int up;
+    int down;
+    double input_rate;
+    double output_rate;
+    bool half_band;
+    std::vector<double> coefficients;
+    std::vector<int> nonzero; // Índices dos coeficientes não nulos
+    double macs;              // MACs por amostra da saída final
+};
+
+struct Plan {
+    std::vector<Stage> stages;
+    double macs;
+};
+
+// Projeta um estágio. Todo estágio deixa passar [0, passband] e rejeita o que cairia em [0, stopband]
+// da saída final depois da decimação: a borda de rejeição é output_rate - stopband (no último
+// estágio, a própria stopband). Um fator 2 que não é o último estágio vira meia banda: transição
+// simétrica em torno de input_rate / 4, de stopband até input_rate / 2 - stopband, com corte
+// exatamente em input_rate / 4 — a sinc zera todos os coeficientes a distância par do centro.
+Stage design_stage(int up, int down, double input_rate, double final_rate, double passband, double stopband, bool last) {
+    Stage stage;
+    stage.up = up;
+    stage.down = down;
+    stage.input_rate = input_rate;
+    stage.output_rate = input_rate * up / down;
+    stage.half_band = up == 1 && down == 2 && !last;
+
+    double filter_rate = input_rate * up; // Taxa do protótipo (polifásico no estágio racional)
+    double stop_edge = last ? stopband : stage.output_rate - stopband;
+    int order;
+    double cutoff;
+    if (stage.half_band) {
+        double transition = input_rate / 2 - 2 * stopband;
+        order = (int) std::ceil(hamming_transition * filter_rate / transition);
+        order = (order + 1) / 4 * 4 + 2; // Ordem 4K + 2: as pontas caem em posições não nulas
+        cutoff = input_rate / 4;
+    } else {
+        double transition = stop_edge - passband;
+        order = (int) std::ceil(hamming_transition * filter_rate / transition);
+        order += order % 2;
+        cutoff = (passband + stop_edge) / 2;
+    }
+    stage.coefficients = freqcomp::generate_fir_coefficients(order, cutoff, filter_rate);
+    for (double& h : stage.coefficients) {
+        h *= up; // Ganho do interpolador
+    }
+
+    double peak = 0.0;
+    for (double h : stage.coefficients) {
+        peak = std::max(peak, std::fabs(h));
+    }
+    for (int k = 0; k < (int) stage.coefficients.size(); k++) {
+        if (std::fabs(stage.coefficients[k]) > 1e-12 * peak) {
+            stage.nonzero.push_back(k);
+        }
+    }
+
+    // Cada saída do estágio usa os coeficientes não nulos de uma fase do protótipo (1 / up deles)
+    stage.macs = (double) stage.nonzero.size() / up * stage.output_rate / final_rate;
+    return stage;
+}
+
+// Procura a cascata de menor custo: estágios inteiros que mantêm a taxa intermediária inteira e
+// acima de passband + stopband, seguidos de um estágio final inteiro ou racional
+void search_plans(int input_rate, int rate, int output_rate, double passband, double stopband, int max_stages,
+                  std::vector<int>& factors, Plan& best) {
+    // Fecha a cascata a partir da taxa atual
+    int g = freqcomp::gcd(rate, output_rate);
+    int up = output_rate / g;
+    int down = rate / g;
+    if (!(up == 1 && down == 1) && (int) factors.size() < max_stages) {
+        Plan plan;
+        plan.macs = 0.0;
+        double current = input_rate;
+        for (int factor : factors) {
+            plan.stages.push_back(design_stage(1, factor, current, output_rate, passband, stopband, false));
+            current /= factor;
+        }
+        plan.stages.push_back(design_stage(up, down, current, output_rate, passband, stopband, true));
+        for (const Stage& stage : plan.stages) {
+            plan.macs += stage.macs;
+        }
+        if (best.stages.empty() || plan.macs < best.macs) {
+            best = plan;
+        }
+    }
+    if ((int) factors.size() + 1 >= max_stages) {
+        return;
+    }
+
+    // Mais um estágio inteiro intermediário
+    for (int factor = 2; factor <= rate; factor++) {
+        if (rate % factor != 0) {
+            continue;
+        }
+        int next = rate / factor;
+        if (next <= passband + stopband || next <= output_rate) {
+            break;
+        }
+        factors.push_back(factor);
+        search_plans(input_rate, next, output_rate, passband, stopband, max_stages, factors, best);
+        factors.pop_back();
+    }
+}
+
+// Melhor cascata com até max_stages estágios; passband e stopband relativos à taxa de saída
+Plan plan_decimation(int input_rate, int output_rate, int max_stages) {
+    double passband = 0.4 * output_rate;
+    double stopband = 0.5 * output_rate;
+    std::vector<int> factors;
+    Plan best;
+    best.macs = std::numeric_limits<double>::max();
+    search_plans(input_rate, input_rate, output_rate, passband, stopband, max_stages, factors, best);
+    return best;
+}
+
+void print_plan(const Plan& plan) {
+    for (size_t i = 0; i < plan.stages.size(); i++) {
+        const Stage& stage = plan.stages[i];
+        std::cout << "  Estágio " << i + 1 << ": " << stage.input_rate << " -> " << stage.output_rate << " Hz (";
+        if (stage.up == 1) {
+            std::cout << "fator " << stage.down;
+        } else {
+            std::cout << "razão " << stage.up << "/" << stage.down;
+        }
+        std::cout << (stage.half_band ? ", meia banda" : "") << "), " << stage.coefficients.size() << " coeficientes ("
+                  << stage.nonzero.size() << " não nulos), " << stage.macs << " MACs por saída" << std::endl;
+    }
+    std::cout << "  Total: " << plan.macs << " MACs por amostra de saída" << std::endl;
+}
+
+// Aplica um estágio ao sinal inteiro, pulando os coeficientes nulos. O atraso de grupo do filtro é
+// compensado para que a saída fique alinhada com a entrada.
+std::vector<double> run_stage(const Stage& stage, const std::vector<double>& input) {
+    const std::vector<double>& h = stage.coefficients;
+    long long delay = (h.size() - 1) / 2; // Em amostras do protótipo
+    long long input_size = input.size();
+    long long output_size = (input_size * stage.up + stage.down - 1) / stage.down;
+    std::vector<double> output(output_size, 0.0);
+
+    // Coeficientes não nulos separados por fase: a fase p usa h[p + j * up] com a entrada i - j
+    std::vector<std::vector<int>> phases(stage.up);
+    for (int k : stage.nonzero) {
+        phases[k % stage.up].push_back(k);
+    }
+
+    for (long long n = 0; n < output_size; n++) {
+        // Posição da saída na taxa do protótipo: amostra de entrada i e fase do polifásico
+        long long t = n * stage.down + delay;
+        long long i = t / stage.up;
+        int phase = t % stage.up;
+        double acc = 0.0;
+        for (int k : phases[phase]) {
+            long long index = i - k / stage.up;
+            if (index >= 0 && index < input_size) {
+                acc += h[k] * input[index];
+            }
+        }
+        output[n] = acc;
+    }
+    return output;
+}
+
+std::vector<double> run_plan(const Plan& plan, std::vector<double> signal) {
+    for (const Stage& stage : plan.stages) {
+        signal = run_stage(stage, signal);
+    }
+    return signal;
+}
+
+// Nível (dB) de um tom na saída da cascata, descartando as bordas
+double tone_level(const Plan& plan, int input_rate, double frequency) {
+    std::vector<double> tone(input_rate); // 1 segundo
+    for (int i = 0; i < input_rate; i++) {
+        tone[i] = sin(2 * PI * frequency * i / input_rate);
+    }
+    std::vector<double> output = run_plan(plan, tone);
+    size_t edge = output.size() / 10;
+    double power = 0.0;
+    for (size_t i = edge; i < output.size() - edge; i++) {
+        power += output[i] * output[i];
+    }
+    power /= output.size() - 2 * edge;
+    return 10 * std::log10(std::max(2 * power, 1e-30));
+}
+
+// Mostra a melhor cascata, a comparação com um único estágio e o efeito em dois tons de teste:
+// um na banda passante e um que cairia (por aliasing) sobre ele sem filtragem
+void report(int input_rate, int output_rate) {
+    std::cout << input_rate << " -> " << output_rate << " Hz" << std::endl;
+    Plan single = plan_decimation(input_rate, output_rate, 1);
+    Plan cascade = plan_decimation(input_rate, output_rate, 4);
+    std::cout << "Um estágio:" << std::endl;
+    print_plan(single);
+    std::cout << "Cascata:" << std::endl;
+    print_plan(cascade);
+    std::cout << "Redução: " << single.macs / cascade.macs << "x" << std::endl;
+
+    double pass_tone = 0.25 * output_rate;
+    double alias_tone = output_rate - pass_tone + 2 * output_rate; // Rebate para pass_tone
+    std::cout << "Tom de " << pass_tone << " Hz: " << tone_level(cascade, input_rate, pass_tone) << " dB; tom de "
+              << alias_tone << " Hz: " << tone_level(cascade, input_rate, alias_tone) << " dB" << std::endl << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 4 && std::string(argv[1]) == "--planejar") {
+        report(std::stoi(argv[2]), std::stoi(argv[3]));
+        return 0;
+    }
+    if (argc == 1) {
+        // Razões grandes usadas nos exemplos: capsfilter de 160 Hz (example7) e 44100 -> 8000
+        report(48000, 160);
+        report(44100, 8000);
+        return 0;
+    }
+    if (argc != 4) {
+        std::cerr << "Uso: " << argv[0] << " [<arquivo_entrada.wav> <frequencia_destino_Hz> <arquivo_saida.wav>]\n";
+        std::cerr << "     " << argv[0] << " --planejar <taxa_entrada> <taxa_saida>\n";
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    int target_frequency = std::stoi(argv[2]);
+    const char* output_file = argv[3];
+
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
+        return 1;
+    }
+    std::vector<double> frames((size_t) sfinfo.frames * sfinfo.channels);
+    sf_readf_double(infile, frames.data(), sfinfo.frames);
+    sf_close(infile);
+
+    Plan plan = plan_decimation(sfinfo.samplerate, target_frequency, 4);
+    print_plan(plan);
+
+    // Cada canal passa pela cascata separadamente
+    std::vector<std::vector<double>> outputs = freqcomp::deinterleave(frames, sfinfo.channels);
+    for (std::vector<double>& channel : outputs) {
+        channel = run_plan(plan, channel);
+    }
+    size_t output_frames = outputs[0].size();
+    std::vector<double> interleaved = freqcomp::interleave(outputs);
+
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = target_frequency;
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        return 1;
+    }
+    sf_writef_double(outfile, interleaved.data(), output_frames);
+    sf_close(outfile);
+
+    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example15                                   (planos para 48000 -> 160 e 44100 -> 8000)
+// ./build/example15 --planejar 96000 1000
+// ./build/example15 media/audio.wav 8000 media/audio_output_multiestagio.wav
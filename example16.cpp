@@ -0,0 +1,150 @@
+// Banco de coeficientes FIR (freqcomp::CoefficientBank): cada projeto (ordem, corte, taxa, janela) é
+// calculado uma única vez por processo, pode ser gravado em um arquivo binário e carregado na
+// inicialização, e as configurações padrão vêm de tabelas constexpr calculadas pelo compilador, sem
+// sin/cos em tempo de execução.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <sndfile.h>
+
+// Banco de coeficientes (com as tabelas constexpr), projeto do filtro e decimador da libfreqcomp
+#include "freqcomp/coefficient_bank.h"
+#include "freqcomp/decimator.h"
+#include "freqcomp/filter.h"
+
+using freqcomp::CoefficientBank;
+using freqcomp::HAMMING;
+using freqcomp::HANN;
+using freqcomp::BLACKMAN;
+using freqcomp::generate_fir_coefficients;
+
+// Confere as tabelas constexpr contra sin/cos da biblioteca (igualdade exata), a memorização e a
+// ida e volta pelo arquivo
+bool verify_bank() {
+    bool ok = true;
+    freqcomp::Span<const freqcomp::StandardFirTable> tables = freqcomp::standard_fir_tables();
+    for (size_t t = 0; t < tables.size(); t++) {
+        const freqcomp::StandardFirTable& table = tables[t];
+        std::vector<double> reference = generate_fir_coefficients(table.order, table.cutoff, table.rate);
+        double max_error = 0.0;
+        for (int k = 0; k <= table.order; k++) {
+            max_error = std::max(max_error, std::fabs(reference[k] - table.coefficients[k]));
+        }
+        bool identical = std::equal(reference.begin(), reference.end(), table.coefficients);
+        std::cout << "Tabela (" << table.order << ", " << table.cutoff << " Hz, " << table.rate << " Hz): "
+                  << (identical ? "idêntica" : "DIFERENTE") << " a generate_fir_coefficients (diferença máxima "
+                  << max_error << ")" << std::endl;
+        ok = ok && identical;
+    }
+
+    // O banco compartilhado, usado pelos pipelines, entrega a tabela e o mesmo resultado do projeto
+    const std::vector<double>& shared = freqcomp::cached_fir_coefficients(31, 4000.0, 44100.0);
+    bool shared_ok = shared == generate_fir_coefficients(31, 4000.0, 44100.0) &&
+                     &shared == &freqcomp::cached_fir_coefficients(31, 4000.0, 44100.0);
+    std::cout << "Banco compartilhado: " << (shared_ok ? "ok" : "FALHOU") << std::endl;
+    ok = ok && shared_ok;
+
+    CoefficientBank bank;
+    const std::vector<double>& first = bank.get(255, 7350.0, 44100.0, BLACKMAN);
+    const std::vector<double>& second = bank.get(255, 7350.0, 44100.0, BLACKMAN);
+    bank.get(31, 4000.0, 44100.0);
+    bank.get(127, 3000.0, 16000.0, HANN);
+    bool memoized = &first == &second && bank.hits() == 1 && bank.misses() == 3 &&
+                    first == generate_fir_coefficients(255, 7350.0, 44100.0, BLACKMAN);
+    std::cout << "Memorização: " << (memoized ? "ok" : "FALHOU") << std::endl;
+    ok = ok && memoized;
+
+    const char* bank_file = "media/verificacao_banco.bin";
+    CoefficientBank loaded;
+    bool round_trip = bank.save(bank_file) && loaded.load(bank_file) && loaded.size() == bank.size() &&
+                      loaded.get(255, 7350.0, 44100.0, BLACKMAN) == first &&
+                      loaded.get(127, 3000.0, 16000.0, HANN) == generate_fir_coefficients(127, 3000.0, 16000.0, HANN) &&
+                      loaded.misses() == 0;
+    std::remove(bank_file);
+    std::cout << "Arquivo do banco: " << (round_trip ? "idêntico" : "DIFERENTE") << std::endl;
+    ok = ok && round_trip;
+
+    // Custo de projetar a cada uso contra buscar no banco
+    const int repetitions = 2000;
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        checksum += generate_fir_coefficients(255, 7350.0, 44100.0, BLACKMAN)[r % 256];
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        checksum += bank.get(255, 7350.0, 44100.0, BLACKMAN)[r % 256];
+    }
+    auto end = std::chrono::steady_clock::now();
+    double design_us = std::chrono::duration<double, std::micro>(middle - start).count() / repetitions;
+    double lookup_us = std::chrono::duration<double, std::micro>(end - middle).count() / repetitions;
+    std::cout << "Projeto de 256 coeficientes: " << design_us << " us; busca no banco: " << lookup_us << " us"
+              << (checksum == 0.0 ? " " : "") << std::endl;
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--verificar") {
+        return verify_bank() ? 0 : 1;
+    }
+    if (argc != 5 && argc != 6) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_entrada.wav> <ordem_filtro> <fator_decimacao> <arquivo_saida.wav> [banco.bin]\n";
+        std::cerr << "     " << argv[0] << " --verificar\n";
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    int filter_order = std::stoi(argv[2]);
+    int factor = std::stoi(argv[3]);
+    const char* output_file = argv[4];
+    std::string bank_file = argc == 6 ? argv[5] : "";
+
+    // O banco gravado em uma execução anterior evita recalcular os projetos já conhecidos
+    CoefficientBank& bank = CoefficientBank::instance();
+    if (!bank_file.empty() && bank.load(bank_file)) {
+        std::cout << "Banco carregado: " << bank.size() << " projetos" << std::endl;
+    }
+
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
+        return 1;
+    }
+    std::vector<double> frames((size_t) sfinfo.frames * sfinfo.channels);
+    sf_readf_double(infile, frames.data(), sfinfo.frames);
+    sf_close(infile);
+
+    double cutoff_frequency = 0.45 * sfinfo.samplerate / factor;
+    const std::vector<double>& coefficients = bank.get(filter_order, cutoff_frequency, sfinfo.samplerate);
+    freqcomp::Decimator<double> decimator(coefficients, factor, sfinfo.channels);
+    std::vector<double> output((size_t) decimator.max_output(sfinfo.frames) * sfinfo.channels);
+    int produced = decimator.process(frames.data(), sfinfo.frames, output.data());
+
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = sfinfo.samplerate / factor;
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        return 1;
+    }
+    sf_writef_double(outfile, output.data(), produced);
+    sf_close(outfile);
+
+    if (!bank_file.empty() && bank.misses() > 0) {
+        bank.save(bank_file);
+    }
+
+    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example16 media/audio.wav 63 3 media/audio_output.wav media/coeficientes.bin   (grava o banco na primeira execução)
+// ./build/example16 --verificar   (tabelas constexpr idênticas a sin/cos, memorização e arquivo do banco)
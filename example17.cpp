@@ -0,0 +1,124 @@
+// Uso da libfreqcomp embutida em outro programa: um Resampler em fluxo contínuo, alimentado em
+// blocos de tamanho fixo com process(entrada, saída), com flush no fim e o atraso informado por latency()
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sndfile.h>
+
+#include "freqcomp/freqcomp.h"
+
+// Compara o Resampler e o Decimator em blocos irregulares com as versões que processam o sinal
+// inteiro (resample_rational e polyphase_decimate), canal a canal
+bool verify_library(const std::vector<double>& interleaved, int channels, int sample_rate) {
+    std::vector<std::vector<double>> planar = freqcomp::deinterleave(interleaved, channels);
+    int frames = planar[0].size();
+    bool identical = true;
+
+    for (int target_rate : {16000, 22050, 8000, 48000}) {
+        freqcomp::Resampler<double> resampler(sample_rate, target_rate, channels);
+        std::vector<double> output;
+        std::vector<double> block((size_t) resampler.max_output(1500) * channels);
+        for (int offset = 0, size = 1; offset < frames; offset += size, size = size * 3 % 1500 + 1) {
+            int count = std::min(size, frames - offset);
+            size_t produced = resampler.process(
+                freqcomp::Span<const double>(interleaved.data() + (size_t) offset * channels, (size_t) count * channels), block);
+            output.insert(output.end(), block.begin(), block.begin() + produced * channels);
+        }
+        block.resize((size_t) resampler.max_output(0) * channels);
+        size_t produced = resampler.flush(block);
+        output.insert(output.end(), block.begin(), block.begin() + produced * channels);
+
+        std::vector<std::vector<double>> reference(channels);
+        for (int c = 0; c < channels; c++) {
+            reference[c] = freqcomp::resample_rational(planar[c], sample_rate, target_rate);
+        }
+        bool same = freqcomp::interleave(reference) == output;
+        std::cout << "Resampler " << sample_rate << " -> " << target_rate << " Hz (L/M = " << resampler.interpolation() << "/"
+                  << resampler.decimation() << ", atraso " << resampler.latency() << " quadros): "
+                  << (same ? "idêntico" : "DIFERENTE") << std::endl;
+        identical = identical && same;
+    }
+
+    std::vector<double> coefficients = freqcomp::generate_fir_coefficients(63, 0.45 * sample_rate / 3, sample_rate);
+    freqcomp::Decimator<double> decimator(coefficients, 3, channels);
+    std::vector<double> output((size_t) decimator.max_output(frames) * channels);
+    output.resize(decimator.process(interleaved, output) * channels);
+    std::vector<std::vector<double>> reference(channels);
+    for (int c = 0; c < channels; c++) {
+        reference[c] = freqcomp::polyphase_decimate(planar[c], coefficients, 3);
+    }
+    bool same = freqcomp::interleave(reference) == output;
+    std::cout << "Decimator fator 3 (atraso " << decimator.latency() << " quadros): " << (same ? "idêntico" : "DIFERENTE") << std::endl;
+    return identical && same;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::string(argv[1]) == "--verificar") {
+        SF_INFO sfinfo;
+        SNDFILE* infile = sf_open(argv[2], SFM_READ, &sfinfo);
+        if (!infile) {
+            std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
+            return 1;
+        }
+        std::vector<double> frames((size_t) sfinfo.frames * sfinfo.channels);
+        sf_readf_double(infile, frames.data(), sfinfo.frames);
+        sf_close(infile);
+        return verify_library(frames, sfinfo.channels, sfinfo.samplerate) ? 0 : 1;
+    }
+    if (argc != 4) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_entrada.wav> <frequencia_destino_Hz> <arquivo_saida.wav>\n";
+        std::cerr << "     " << argv[0] << " --verificar <arquivo.wav>\n";
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    int target_frequency = std::stoi(argv[2]);
+    const char* output_file = argv[3];
+
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir o arquivo WAV!" << std::endl;
+        return 1;
+    }
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = target_frequency;
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao criar o arquivo WAV de saída!" << std::endl;
+        sf_close(infile);
+        return 1;
+    }
+
+    int channels = sfinfo.channels;
+    freqcomp::Resampler<float> resampler(sfinfo.samplerate, target_frequency, channels);
+    std::cout << "Razão " << resampler.interpolation() << "/" << resampler.decimation() << ", atraso de "
+              << resampler.latency() << " quadros de entrada" << std::endl;
+
+    // Buffers de tamanho fixo, reaproveitados a cada bloco
+    const int block_frames = 4096;
+    std::vector<float> input_block((size_t) block_frames * channels);
+    std::vector<float> output_block((size_t) resampler.max_output(block_frames) * channels);
+
+    sf_count_t frames_read;
+    while ((frames_read = sf_readf_float(infile, input_block.data(), block_frames)) > 0) {
+        size_t produced = resampler.process(
+            freqcomp::Span<const float>(input_block.data(), (size_t) frames_read * channels), output_block);
+        sf_writef_float(outfile, output_block.data(), produced);
+    }
+    size_t produced = resampler.flush(output_block);
+    sf_writef_float(outfile, output_block.data(), produced);
+
+    sf_close(infile);
+    sf_close(outfile);
+
+    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example17 media/audio.wav 16000 media/audio_output.wav
+// ./build/example17 --verificar media/audio.wav   (Resampler e Decimator em blocos idênticos às versões do sinal inteiro)
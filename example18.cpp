@@ -0,0 +1,76 @@
+// Mesmo pipeline do example3, com o elemento freqcompress (libfreqcomp) no lugar do audioresample
+
+#include <gst/gst.h>
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+    gst_init(&argc, &argv); // Inicializa o GStreamer
+
+    // Sem GST_PLUGIN_PATH, procura o plugin na pasta em que o CMake o compilou
+    GstElementFactory *factory = gst_element_factory_find("freqcompress");
+#ifdef FREQCOMP_GST_PLUGIN_DIR
+    if (!factory) {
+        gst_registry_scan_path(gst_registry_get(), FREQCOMP_GST_PLUGIN_DIR);
+        factory = gst_element_factory_find("freqcompress");
+    }
+#endif
+    if (!factory) {
+        std::cerr << "Erro ao carregar o elemento freqcompress! Defina GST_PLUGIN_PATH com a pasta do libgstfreqcompress.so" << std::endl;
+        return -1;
+    }
+    gst_object_unref(factory);
+
+    // A taxa de saída vem do capsfilter, como no example3; quality e taps ajustam o filtro
+    GstElement *pipeline = gst_parse_launch(
+        "filesrc location=media/audio.wav ! decodebin ! "
+        "audioconvert ! freqcompress quality=3 ! "
+        "capsfilter caps=audio/x-raw,rate=16000 ! "
+        "audioconvert ! wavenc ! filesink location=media/audio_output_gst.wav",
+        NULL);
+
+    if (!pipeline) {
+        std::cerr << "Erro ao criar o pipeline GStreamer!" << std::endl;
+        return -1;
+    }
+
+    // Inicia o pipeline
+    GstStateChangeReturn ret = gst_element_set_state(pipeline, GST_STATE_PLAYING);
+    if (ret == GST_STATE_CHANGE_FAILURE) {
+        std::cerr << "Erro ao executar o pipeline!" << std::endl;
+        gst_object_unref(pipeline);
+        return -1;
+    }
+
+    // Espera até o pipeline terminar o processamento
+    GstBus *bus = gst_element_get_bus(pipeline);
+    GstMessage *msg = gst_bus_timed_pop_filtered(bus, GST_CLOCK_TIME_NONE,
+                                                 static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+    bool failed = msg && GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ERROR;
+    if (failed) {
+        GError *error = NULL;
+        gst_message_parse_error(msg, &error, NULL);
+        std::cerr << "Erro no pipeline: " << error->message << std::endl;
+        g_error_free(error);
+    }
+    if (msg) {
+        gst_message_unref(msg);
+    }
+
+    // Libera os recursos do pipeline
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(pipeline);
+    gst_object_unref(bus);
+
+    if (failed) {
+        return -1;
+    }
+    std::cout << "Processamento concluído! Arquivo salvo como media/audio_output_gst.wav" << std::endl;
+    return 0;
+}
+
+// Example:
+// GST_PLUGIN_PATH=build gst-launch-1.0 filesrc location=media/audio.wav ! decodebin ! audioconvert ! freqcompress target-rate=16000 ! audioconvert ! autoaudiosink
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example18
@@ -0,0 +1,295 @@
+// Áudio ao vivo pelo decimador da libfreqcomp: o appsink entrega os buffers do microfone, uma
+// thread dedicada os decima com freqcomp::Decimator e o appsrc envia o resultado para a saída.
+// Os buffers de saída vêm de um GstBufferPool: o decimador escreve direto na memória do buffer e,
+// quando a saída termina de usá-lo, ele volta para o pool, sem alocação por bloco.
+
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "freqcomp/coefficient_bank.h"
+#include "freqcomp/decimator.h"
+
+// Formato trocado com o pipeline: float intercalado, na ordem de bytes da máquina (x86 e ARM: little-endian)
+#define SAMPLE_FORMAT "F32LE"
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void on_signal(int) {
+    stop_requested = 1;
+}
+
+// Estado da thread de processamento
+struct Bridge {
+    GstAppSink *appsink;
+    GstAppSrc *appsrc;
+    GstBufferPool *pool;
+    freqcomp::Decimator<float> *decimator;
+    int channels;
+    int input_rate;
+    int output_rate;
+    int max_frames;             // Maior bloco de entrada que cabe em um buffer do pool
+    GstClockTime start_time;    // PTS do primeiro buffer de entrada (ou do primeiro depois de um salto)
+    guint64 frames_in;          // Quadros de entrada recebidos desde start_time
+    guint64 frames_out;         // Quadros de saída enviados desde start_time
+    bool discont;               // O próximo buffer de saída começa depois de um salto
+    guint64 buffers_in;
+    guint64 buffers_out;
+};
+
+// Decima "frames" quadros em um buffer do pool e o envia pelo appsrc
+static bool push_block(Bridge &bridge, const float *input, int frames) {
+    GstBuffer *output = NULL;
+    if (gst_buffer_pool_acquire_buffer(bridge.pool, &output, NULL) != GST_FLOW_OK) {
+        return false;
+    }
+
+    GstMapInfo map;
+    if (!gst_buffer_map(output, &map, GST_MAP_WRITE)) {
+        std::cerr << "Erro ao mapear o buffer de saída!" << std::endl;
+        gst_buffer_unref(output);
+        return false;
+    }
+    int produced = bridge.decimator->process(input, frames, reinterpret_cast<float*>(map.data));
+    gst_buffer_unmap(output, &map);
+
+    if (produced == 0) {
+        gst_buffer_unref(output); // Volta para o pool
+        return true;
+    }
+    gst_buffer_set_size(output, (gsize) produced * bridge.channels * sizeof(float));
+
+    // Tempos a partir dos quadros já enviados, sem acumular arredondamento
+    GstClockTime begin = gst_util_uint64_scale_int_round(bridge.frames_out, GST_SECOND, bridge.output_rate);
+    GstClockTime end = gst_util_uint64_scale_int_round(bridge.frames_out + produced, GST_SECOND, bridge.output_rate);
+    GST_BUFFER_PTS(output) = bridge.start_time + begin;
+    GST_BUFFER_DURATION(output) = end - begin;
+    if (bridge.discont) {
+        GST_BUFFER_FLAG_SET(output, GST_BUFFER_FLAG_DISCONT);
+        bridge.discont = false;
+    }
+    bridge.frames_out += produced;
+    bridge.buffers_out++;
+
+    // O appsrc fica com a referência; o buffer volta ao pool quando a saída o libera. Com a fila do
+    // appsrc cheia (max-bytes), a chamada bloqueia até a saída consumir.
+    return gst_app_src_push_buffer(bridge.appsrc, output) == GST_FLOW_OK;
+}
+
+// Ao vivo, o appsink descarta buffers quando a thread atrasa (drop=true) sem avisar: os tempos de
+// saída, contados pelos quadros enviados, ficariam atrás do relógio a cada descarte. Se o PTS da
+// entrada se afasta do esperado em mais de meio buffer (ou o buffer vem marcado como
+// descontinuidade), recomeça a contagem nele, com a linha de atraso zerada.
+static void anchor_input(Bridge &bridge, GstBuffer *input, int frames) {
+    if (!GST_BUFFER_PTS_IS_VALID(input)) {
+        if (bridge.start_time == GST_CLOCK_TIME_NONE) {
+            bridge.start_time = 0;
+        }
+        return;
+    }
+    GstClockTime pts = GST_BUFFER_PTS(input);
+    if (bridge.start_time != GST_CLOCK_TIME_NONE) {
+        GstClockTime expected = bridge.start_time + gst_util_uint64_scale_int_round(bridge.frames_in, GST_SECOND, bridge.input_rate);
+        GstClockTime tolerance = gst_util_uint64_scale_int_round(frames, GST_SECOND, 2 * bridge.input_rate);
+        GstClockTime drift = pts > expected ? pts - expected : expected - pts;
+        if (drift <= tolerance && !GST_BUFFER_IS_DISCONT(input)) {
+            return;
+        }
+        std::cerr << "Salto de " << (double) drift / GST_MSECOND << " ms na entrada; recomeçando os tempos" << std::endl;
+        bridge.decimator->reset();
+        bridge.discont = true;
+    }
+    bridge.start_time = pts;
+    bridge.frames_in = 0;
+    bridge.frames_out = 0;
+}
+
+// Thread de processamento: bloqueia no appsink até chegar um buffer; termina no fim do fluxo ou
+// quando o pipeline para
+static void processing_thread(Bridge *bridge) {
+    GstSample *sample;
+    while ((sample = gst_app_sink_pull_sample(bridge->appsink)) != NULL) {
+        GstBuffer *input = gst_sample_get_buffer(sample);
+        GstMapInfo map;
+        if (input && gst_buffer_map(input, &map, GST_MAP_READ)) {
+            // O decimador lê direto da memória do buffer de entrada
+            const float *frames = reinterpret_cast<const float*>(map.data);
+            int count = map.size / (bridge->channels * sizeof(float));
+            anchor_input(*bridge, input, count);
+            bridge->frames_in += count;
+            bool ok = true;
+            for (int offset = 0; ok && offset < count; offset += bridge->max_frames) {
+                int block = std::min(bridge->max_frames, count - offset);
+                ok = push_block(*bridge, frames + (size_t) offset * bridge->channels, block);
+            }
+            gst_buffer_unmap(input, &map);
+            bridge->buffers_in++;
+            if (!ok) {
+                gst_sample_unref(sample);
+                break;
+            }
+        }
+        gst_sample_unref(sample);
+    }
+    gst_app_src_end_of_stream(bridge->appsrc);
+}
+
+// Libera o pool, o appsink, o appsrc e o pipeline (já em NULL ou nunca iniciado); usada em todas as saídas de main
+static void release_pipeline(GstElement *pipeline, Bridge &bridge) {
+    if (bridge.pool) {
+        gst_buffer_pool_set_active(bridge.pool, FALSE);
+        gst_object_unref(bridge.pool);
+    }
+    if (bridge.appsink) gst_object_unref(bridge.appsink);
+    if (bridge.appsrc) gst_object_unref(bridge.appsrc);
+    gst_object_unref(pipeline);
+}
+
+int main(int argc, char *argv[]) {
+    gst_init(&argc, &argv);
+
+    // Argumentos: [--fator N] [--arquivo entrada.wav]. Sem --arquivo, captura o microfone.
+    int factor = 3;
+    std::string input_file;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--fator" && i + 1 < argc) {
+            factor = std::atoi(argv[++i]);
+        } else if (arg == "--arquivo" && i + 1 < argc) {
+            input_file = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--fator N] [--arquivo entrada.wav]\n";
+            return 1;
+        }
+    }
+    const int input_rate = 48000;
+    if (factor < 1 || input_rate % factor != 0) {
+        std::cerr << "Erro: o fator de decimação deve dividir " << input_rate << "!" << std::endl;
+        return 1;
+    }
+
+    const int channels = 1;
+    const int output_rate = input_rate / factor;
+    bool live = input_file.empty();
+
+    std::string input_caps = "audio/x-raw,format=" SAMPLE_FORMAT ",layout=interleaved,rate=" + std::to_string(input_rate) +
+                             ",channels=" + std::to_string(channels);
+    std::string output_caps = "audio/x-raw,format=" SAMPLE_FORMAT ",layout=interleaved,rate=" + std::to_string(output_rate) +
+                              ",channels=" + std::to_string(channels);
+
+    // Um só pipeline com dois ramos (mesmo relógio): fonte -> appsink e appsrc -> saída. Ao vivo, o
+    // appsink descarta os buffers mais antigos se a thread atrasar, em vez de travar a captura; com
+    // arquivo, a fila cheia só segura a leitura.
+    std::string source = live ? "autoaudiosrc" : "filesrc location=" + input_file + " ! decodebin";
+    std::string description =
+        source + " ! audioconvert ! audioresample ! " + input_caps + " ! "
+        "appsink name=entrada sync=false max-buffers=16 drop=" + (live ? "true" : "false") + " "
+        "appsrc name=saida format=time caps=" + output_caps + " ! audioconvert ! autoaudiosink";
+
+    GError *error = NULL;
+    GstElement *pipeline = gst_parse_launch(description.c_str(), &error);
+    if (!pipeline) {
+        std::cerr << "Erro ao criar o pipeline GStreamer: " << (error ? error->message : "") << std::endl;
+        if (error) g_error_free(error);
+        return -1;
+    }
+
+    // Filtro do decimador: mesmo critério de resample_rational (16 cruzamentos por zero, corte em 0,45 * saída);
+    // o fator padrão 3 usa a tabela constexpr do banco
+    const std::vector<double>& coefficients = freqcomp::cached_fir_coefficients(32 * factor, 0.45 * output_rate, input_rate);
+    freqcomp::Decimator<float> decimator(coefficients, factor, channels);
+
+    Bridge bridge;
+    bridge.appsink = GST_APP_SINK(gst_bin_get_by_name(GST_BIN(pipeline), "entrada"));
+    bridge.appsrc = GST_APP_SRC(gst_bin_get_by_name(GST_BIN(pipeline), "saida"));
+    bridge.decimator = &decimator;
+    bridge.channels = channels;
+    bridge.input_rate = input_rate;
+    bridge.output_rate = output_rate;
+    bridge.max_frames = 4096;
+    bridge.start_time = GST_CLOCK_TIME_NONE;
+    bridge.frames_in = 0;
+    bridge.frames_out = 0;
+    bridge.discont = false;
+    bridge.buffers_in = 0;
+    bridge.buffers_out = 0;
+
+    // Pool de buffers de saída, cada um com espaço para a decimação de max_frames quadros. O máximo é
+    // fixo: com todos em uso, acquire espera a saída devolver um, em vez de alocar outro
+    const guint pool_min_buffers = 8;
+    const guint pool_max_buffers = 16;
+    guint buffer_bytes = decimator.max_output(bridge.max_frames) * channels * sizeof(float);
+    GstCaps *caps = gst_caps_from_string(output_caps.c_str());
+    bridge.pool = gst_buffer_pool_new();
+    GstStructure *config = gst_buffer_pool_get_config(bridge.pool);
+    gst_buffer_pool_config_set_params(config, caps, buffer_bytes, pool_min_buffers, pool_max_buffers);
+    gst_caps_unref(caps);
+    if (!gst_buffer_pool_set_config(bridge.pool, config) || !gst_buffer_pool_set_active(bridge.pool, TRUE)) {
+        std::cerr << "Erro ao configurar o pool de buffers!" << std::endl;
+        release_pipeline(pipeline, bridge);
+        return -1;
+    }
+
+    // Ao vivo, a saída espera um período da fonte (10 ms por padrão), o atraso de grupo do filtro e uma
+    // folga para a thread de processamento antes de tocar cada buffer
+    GstClockTime filter_delay = (GstClockTime) (decimator.latency() * GST_SECOND / input_rate);
+    g_object_set(bridge.appsrc, "is-live", live ? TRUE : FALSE, "min-latency", (gint64) (20 * GST_MSECOND + filter_delay), NULL);
+
+    // Contrapressão: com arquivo, o appsink não sincroniza e a thread decimaria o arquivo inteiro na
+    // fila do appsrc. Com block=true, push_buffer espera quando a fila passa de metade do pool.
+    g_object_set(bridge.appsrc, "block", TRUE, "max-bytes", (guint64) buffer_bytes * (pool_max_buffers / 2), NULL);
+
+    if (gst_element_set_state(pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        std::cerr << "Erro ao executar o pipeline!" << std::endl;
+        gst_element_set_state(pipeline, GST_STATE_NULL);
+        release_pipeline(pipeline, bridge);
+        return -1;
+    }
+    std::cout << input_rate << " Hz -> " << output_rate << " Hz com freqcomp::Decimator (" << coefficients.size()
+              << " coeficientes, atraso de " << decimator.latency() << " amostras). Pressione Ctrl+C para parar." << std::endl;
+
+    // Os buffers que chegarem antes da thread começar ficam na fila do appsink
+    std::signal(SIGINT, on_signal);
+    std::thread worker(processing_thread, &bridge);
+
+    // Espera o fim do fluxo, um erro ou Ctrl+C
+    GstBus *bus = gst_element_get_bus(pipeline);
+    while (!stop_requested) {
+        GstMessage *msg = gst_bus_timed_pop_filtered(bus, 100 * GST_MSECOND,
+                                                     static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+        if (msg) {
+            if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ERROR) {
+                GError *err = NULL;
+                gst_message_parse_error(msg, &err, NULL);
+                std::cerr << "Erro no pipeline: " << err->message << std::endl;
+                g_error_free(err);
+            }
+            gst_message_unref(msg);
+            break;
+        }
+    }
+
+    // Parar o pipeline desbloqueia o appsink, o push_buffer bloqueado do appsrc e o acquire do pool
+    // (a saída devolve os buffers) e encerra a thread de processamento
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    worker.join();
+
+    gst_object_unref(bus);
+    release_pipeline(pipeline, bridge);
+
+    std::cout << "Processamento concluído! " << bridge.buffers_in << " buffers recebidos, " << bridge.buffers_out
+              << " enviados." << std::endl;
+    return 0;
+}
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example19                                   (microfone, 48 kHz -> 16 kHz)
+// ./build/example19 --fator 6 --arquivo media/audio.wav
@@ -1,55 +1,173 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <sndfile.h> // Biblioteca para manipulação de arquivos WAV
 
-#define PI 3.14159265358979323846
+// Filtro, núcleos SIMD e decimador em fluxo contínuo da libfreqcomp
+#include "freqcomp/decimator.h"
+#include "freqcomp/filter.h"
+#include "freqcomp/kernels.h"
 
-// Função para gerar coeficientes FIR com uma janela de Hamming
-std::vector<double> generate_fir_coefficients(int filter_order, double cutoff_frequency, double sampling_rate) {
-    std::vector<double> coefficients(filter_order + 1);
-    double norm_cutoff = cutoff_frequency / (sampling_rate / 2); // Normalizando a frequência de corte
+// A leitura tipada do WAV mapeado (decimate_view) precisa ser idêntica bit a bit aos núcleos da
+// biblioteca: multiplicação e soma não podem ser fundidas em FMA
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
 
-    for (int i = 0; i <= filter_order; i++) {
-        int middle = filter_order / 2;
-        if (i == middle) {
-            coefficients[i] = norm_cutoff;
-        } else {
-            double sinc_value = sin(PI * norm_cutoff * (i - middle)) / (PI * (i - middle));
-            coefficients[i] = sinc_value * (0.54 - 0.46 * cos(2 * PI * i / filter_order)); // Janela de Hamming
-        }
+// Leitura e escrita de quadros na precisão usada pelo processamento
+sf_count_t read_frames(SNDFILE* file, double* data, sf_count_t frames) { return sf_readf_double(file, data, frames); }
+sf_count_t read_frames(SNDFILE* file, float* data, sf_count_t frames) { return sf_readf_float(file, data, frames); }
+sf_count_t write_frames(SNDFILE* file, const double* data, sf_count_t frames) { return sf_writef_double(file, data, frames); }
+sf_count_t write_frames(SNDFILE* file, const float* data, sf_count_t frames) { return sf_writef_float(file, data, frames); }
+
+// Função para processar um arquivo WAV em blocos (leitura -> filtro -> escrita)
+template <typename Sample>
+void process_audio(const char* input_file, const char* output_file, int filter_order, double cutoff_freq, int downsample_factor) {
+    // Abrir arquivo WAV
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir arquivo WAV!" << std::endl;
+        return;
+    }
+
+    // Criar filtro FIR
+    std::vector<double> fir_coeffs = freqcomp::generate_fir_coefficients(filter_order, cutoff_freq, sfinfo.samplerate);
+
+    // Configurar metadados para o novo arquivo WAV
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = sfinfo.samplerate / downsample_factor;
+
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao salvar arquivo WAV!" << std::endl;
+        sf_close(infile);
+        return;
     }
-    return coefficients;
+
+    // Um único decimador filtra todos os canais direto dos quadros intercalados
+    int channels = sfinfo.channels;
+    freqcomp::Decimator<Sample> decimator(fir_coeffs, downsample_factor, channels);
+
+    // Buffers de tamanho fixo, reaproveitados a cada bloco
+    const int block_frames = 4096;
+    std::vector<Sample> input_block(block_frames * channels);
+    std::vector<Sample> output_block(decimator.max_output(block_frames) * channels);
+
+    sf_count_t frames_read;
+    while ((frames_read = read_frames(infile, input_block.data(), block_frames)) > 0) {
+        int produced = decimator.process(input_block.data(), frames_read, output_block.data());
+        write_frames(outfile, output_block.data(), produced);
+    }
+
+    sf_close(infile);
+    sf_close(outfile);
+
+    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
 }
 
-// Aplica o filtro FIR ao áudio
-std::vector<double> apply_fir_filter(const std::vector<double>& input_signal, const std::vector<double>& coefficients) {
-    int filter_size = coefficients.size();
-    int signal_size = input_signal.size();
-    std::vector<double> output_signal(signal_size, 0.0);
+// Decimação paralela de um único sinal longo. O sinal é dividido em trechos de chunk_frames
+// quadros (múltiplo do fator, para que a grade de decimação continue a mesma); cada thread
+// filtra um trecho de cada vez com seu próprio decimador, iniciado com os filter_size - 1
+// quadros anteriores ao trecho como linha de atraso. Cada saída depende só dessas amostras e
+// dos coeficientes, somados na mesma ordem, então o resultado é idêntico bit a bit ao serial.
+// read_at(worker, início, quadros, destino) lê quadros intercalados de qualquer posição; write
+// recebe as saídas de cada trecho na ordem do sinal, na thread que chamou a função.
+template <typename Sample>
+void parallel_decimate(sf_count_t total_frames, int channels, const std::vector<double>& coefficients, int factor,
+                       int thread_count, sf_count_t chunk_frames,
+                       const std::function<void(int, sf_count_t, sf_count_t, Sample*)>& read_at,
+                       const std::function<void(const Sample*, int)>& write) {
+    int overlap = coefficients.size() - 1;
+    chunk_frames = std::max<sf_count_t>(factor, chunk_frames / factor * factor);
+    int chunk_count = (total_frames + chunk_frames - 1) / chunk_frames;
+
+    // Trechos prontos aguardando a escrita em ordem; as threads não se adiantam mais que
+    // 2 trechos cada em relação à escrita, o que limita a memória usada
+    std::vector<std::vector<Sample>> results(chunk_count);
+    std::vector<bool> done(chunk_count, false);
+    int written = 0;
+    int next_chunk = 0;
+    const int window = 2 * thread_count;
+    std::mutex mutex;
+    std::condition_variable chunk_done, chunk_written;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count; t++) {
+        workers.emplace_back([&, t]() {
+            freqcomp::Decimator<Sample> decimator(coefficients, factor, channels);
+            std::vector<Sample> frames;
+            for (;;) {
+                int chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    chunk_written.wait(lock, [&]() { return next_chunk < written + window || next_chunk >= chunk_count; });
+                    if (next_chunk >= chunk_count) {
+                        return;
+                    }
+                    chunk = next_chunk++;
+                }
+
+                sf_count_t start = chunk * chunk_frames;
+                int count = std::min(chunk_frames, total_frames - start);
+                int history = std::min<sf_count_t>(overlap, start);
+                frames.resize((size_t) (history + count) * channels);
+                read_at(t, start - history, history + count, frames.data());
+
+                decimator.prime(frames.data(), history);
+                std::vector<Sample> output((size_t) decimator.max_output(count) * channels);
+                int produced = decimator.process(frames.data() + (size_t) history * channels, count, output.data());
+                output.resize((size_t) produced * channels);
 
-    for (int n = 0; n < signal_size; n++) {
-        for (int k = 0; k < filter_size; k++) {
-            if (n >= k) {
-                output_signal[n] += coefficients[k] * input_signal[n - k];
+                std::lock_guard<std::mutex> lock(mutex);
+                results[chunk].swap(output);
+                done[chunk] = true;
+                chunk_done.notify_all();
             }
+        });
+    }
+
+    for (int chunk = 0; chunk < chunk_count; chunk++) {
+        std::vector<Sample> output;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            chunk_done.wait(lock, [&]() { return done[chunk]; });
+            output.swap(results[chunk]);
+        }
+        write(output.data(), output.size() / channels);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            written++;
         }
+        chunk_written.notify_all();
     }
-    return output_signal;
-}
 
-// Função para reduzir a taxa de amostragem (decimação)
-std::vector<double> downsample(const std::vector<double>& signal, int factor) {
-    std::vector<double> downsampled_signal;
-    for (size_t i = 0; i < signal.size(); i += factor) {
-        downsampled_signal.push_back(signal[i]);
+    for (std::thread& worker : workers) {
+        worker.join();
     }
-    return downsampled_signal;
 }
 
-// Função para processar um arquivo WAV
-void process_audio(const char* input_file, const char* output_file, int filter_order, double cutoff_freq, int downsample_factor) {
-    // Abrir arquivo WAV
+// Versão paralela de process_audio: cada thread lê seus trechos com um SNDFILE próprio
+template <typename Sample>
+void process_audio_parallel(const char* input_file, const char* output_file, int filter_order, double cutoff_freq,
+                            int downsample_factor, int thread_count) {
     SF_INFO sfinfo;
     SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
     if (!infile) {
@@ -57,38 +175,559 @@ void process_audio(const char* input_file, const char* output_file, int filter_o
         return;
     }
 
-    // Ler áudio do arquivo
-    std::vector<double> input_audio(sfinfo.frames);
-    sf_read_double(infile, input_audio.data(), sfinfo.frames);
-    sf_close(infile);
+    std::vector<double> fir_coeffs = freqcomp::generate_fir_coefficients(filter_order, cutoff_freq, sfinfo.samplerate);
 
-    // Criar filtro FIR
-    std::vector<double> fir_coeffs = generate_fir_coefficients(filter_order, cutoff_freq, sfinfo.samplerate);
+    SF_INFO out_sfinfo = sfinfo;
+    out_sfinfo.samplerate = sfinfo.samplerate / downsample_factor;
+    SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
+    if (!outfile) {
+        std::cerr << "Erro ao salvar arquivo WAV!" << std::endl;
+        sf_close(infile);
+        return;
+    }
 
-    // Aplicar filtro FIR
-    std::vector<double> filtered_audio = apply_fir_filter(input_audio, fir_coeffs);
+    std::vector<SNDFILE*> readers(thread_count, nullptr);
+    readers[0] = infile;
+    for (int t = 1; t < thread_count; t++) {
+        SF_INFO info;
+        readers[t] = sf_open(input_file, SFM_READ, &info);
+        if (!readers[t]) {
+            std::cerr << "Erro ao abrir arquivo WAV!" << std::endl;
+            for (SNDFILE* reader : readers) {
+                if (reader) {
+                    sf_close(reader);
+                }
+            }
+            sf_close(outfile);
+            return;
+        }
+    }
 
-    // Reduzir a taxa de amostragem (decimação)
-    std::vector<double> downsampled_audio = downsample(filtered_audio, downsample_factor);
+    auto start = std::chrono::steady_clock::now();
+    parallel_decimate<Sample>(sfinfo.frames, sfinfo.channels, fir_coeffs, downsample_factor, thread_count, 1 << 18,
+        [&](int worker, sf_count_t first, sf_count_t frames, Sample* data) {
+            sf_seek(readers[worker], first, SEEK_SET);
+            read_frames(readers[worker], data, frames);
+        },
+        [&](const Sample* data, int frames) { write_frames(outfile, data, frames); });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-    // Configurar metadados para o novo arquivo WAV
-    SF_INFO out_sfinfo = sfinfo;
-    out_sfinfo.frames = downsampled_audio.size();
-    out_sfinfo.samplerate = sfinfo.samplerate / downsample_factor;
+    for (SNDFILE* reader : readers) {
+        if (reader) {
+            sf_close(reader);
+        }
+    }
+    sf_close(outfile);
+
+    std::cout << "Processamento concluído em " << seconds << " s com " << thread_count
+              << " threads! Arquivo salvo como " << output_file << std::endl;
+}
+
+// Vista tipada das amostras de um WAV mapeado (Stored = int16_t ou float): quadros intercalados lidos
+// no próprio mapeamento e convertidos para float na leitura (PCM de 16 bits dividido por 32768, como
+// o libsndfile faz). Lê com memcpy, que vira uma carga simples, sem supor alinhamento.
+template <typename Stored>
+struct MappedSamples {
+    const unsigned char* data;
+    int channels;
+
+    float operator()(sf_count_t frame, int channel) const {
+        Stored value;
+        std::memcpy(&value, data + ((size_t) frame * channels + channel) * sizeof(Stored), sizeof(Stored));
+        return to_float(value);
+    }
+
+    static float to_float(float value) { return value; }
+    static float to_float(int16_t value) { return value / 32768.0f; }
+};
+
+// Arquivo WAV sem compressão mapeado em memória (PCM de 16 bits ou float de 32 bits, little-endian).
+// O cabeçalho RIFF é interpretado diretamente e as amostras são lidas no próprio mapeamento, direto
+// do cache de páginas, sem a cópia e a conversão do sf_read_* nem um vetor do tamanho do arquivo.
+class MappedWav {
+public:
+    enum Encoding { PCM_16, FLOAT_32 };
+
+    MappedWav() : base(nullptr), length(0), data(nullptr), channels(0), samplerate(0), frames(0), encoding(PCM_16) {}
+
+    ~MappedWav() {
+        if (base) {
+            munmap(base, length);
+        }
+    }
+
+    MappedWav(const MappedWav&) = delete;
+    MappedWav& operator=(const MappedWav&) = delete;
+
+    // Retorna false se o arquivo não puder ser mapeado ou não for PCM 16 / float 32
+    bool open(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < 12) {
+            close(fd);
+            return false;
+        }
+        length = info.st_size;
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            length = 0;
+            return false;
+        }
+        base = static_cast<unsigned char*>(mapping);
+        // Leitura do início ao fim: o kernel pode ler adiante e liberar as páginas já usadas
+        madvise(base, length, MADV_SEQUENTIAL);
+        return parse();
+    }
+
+    int channel_count() const { return channels; }
+    int sample_rate() const { return samplerate; }
+    sf_count_t frame_count() const { return frames; }
+    Encoding sample_encoding() const { return encoding; }
+
+    // Amostras float lidas direto do mapeamento (quadros intercalados), para os núcleos SIMD. Só existe
+    // quando a região de amostras está alinhada a 4 bytes; senão (um cabeçalho de tamanho ímpar de
+    // pares de bytes, como o de media/audio.wav), retorna nullptr e as amostras são lidas por samples().
+    const float* float32() const {
+        if (encoding != FLOAT_32 || reinterpret_cast<uintptr_t>(data) % alignof(float) != 0) {
+            return nullptr;
+        }
+        return reinterpret_cast<const float*>(data);
+    }
+
+    // Vista tipada sobre o mapeamento; Stored precisa corresponder a sample_encoding()
+    template <typename Stored>
+    MappedSamples<Stored> samples() const {
+        MappedSamples<Stored> view = {data, channels};
+        return view;
+    }
+
+private:
+    static uint32_t read_u32(const unsigned char* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    static uint16_t read_u16(const unsigned char* p) { uint16_t v; std::memcpy(&v, p, 2); return v; }
+
+    bool parse() {
+        if (std::memcmp(base, "RIFF", 4) != 0 || std::memcmp(base + 8, "WAVE", 4) != 0) {
+            return false;
+        }
+        bool have_format = false;
+        size_t offset = 12;
+        while (offset + 8 <= length) {
+            const unsigned char* chunk = base + offset;
+            size_t size = read_u32(chunk + 4);
+            size_t available = length - offset - 8;
+            if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16 && size <= available) {
+                // WAVE_FORMAT_EXTENSIBLE guarda o formato real no início do GUID do subformato
+                uint16_t tag = read_u16(chunk + 8);
+                if (tag == 0xFFFE && size >= 40) {
+                    tag = read_u16(chunk + 8 + 24);
+                }
+                channels = read_u16(chunk + 10);
+                samplerate = read_u32(chunk + 12);
+                uint16_t bits = read_u16(chunk + 22);
+                if (tag == 1 && bits == 16) {
+                    encoding = PCM_16;
+                } else if (tag == 3 && bits == 32) {
+                    encoding = FLOAT_32;
+                } else {
+                    return false;
+                }
+                have_format = channels > 0;
+            } else if (std::memcmp(chunk, "data", 4) == 0 && have_format) {
+                // Arquivos truncados: usa só os quadros completos presentes no arquivo
+                size_t frame_bytes = (size_t) channels * (encoding == PCM_16 ? 2 : 4);
+                data = chunk + 8;
+                frames = std::min(size, available) / frame_bytes;
+                return true;
+            }
+            offset += 8 + size + (size & 1);
+        }
+        return false;
+    }
+
+    unsigned char* base;
+    size_t length;
+    const unsigned char* data;
+    int channels;
+    int samplerate;
+    sf_count_t frames;
+    Encoding encoding;
+};
+
+// Filtra e decima "count" saídas a partir da saída m0 lendo as amostras direto da vista. A soma é a
+// mesma de fir_kernel_range (coeficientes em ordem crescente, acumulador float, sem FMA), então o
+// resultado é idêntico ao do Decimator<float>. Amostras antes do início do arquivo valem zero e são
+// puladas: somar c * 0 a um acumulador iniciado em +0 não muda o resultado.
+template <typename Stored>
+void decimate_view(const MappedSamples<Stored>& view, const std::vector<float>& coefficients, int factor, sf_count_t m0, int count,
+                   float* output) {
+    int filter_size = coefficients.size();
+    int channels = view.channels;
+    for (int m = 0; m < count; m++) {
+        sf_count_t newest = (m0 + m) * factor;
+        int taps = (int) std::min<sf_count_t>(filter_size, newest + 1);
+        for (int c = 0; c < channels; c++) {
+            float acc = 0;
+            for (int k = 0; k < taps; k++) {
+                acc += coefficients[k] * view(newest - k, c);
+            }
+            output[(size_t) m * channels + c] = acc;
+        }
+    }
+}
+
+// Filtra e decima um WAV mapeado em precisão simples; a saída é idêntica a process_audio<float>.
+// Em todos os formatos as amostras são lidas no próprio mapeamento, sem cópia para um bloco:
+// - float 32 alinhado, com canais que preenchem os registradores SIMD (Decimator::interleaved_kernel):
+//   os núcleos SIMD da biblioteca (só o início do sinal, com a linha de atraso zerada, passa por uma janela);
+// - PCM de 16 bits e float 32 nos demais casos (inclusive desalinhado, como media/audio.wav):
+//   decimate_view, com a conversão para float feita na leitura de cada amostra.
+// Retorna o nome do caminho usado.
+const char* decimate_mapped(const MappedWav& wav, const std::vector<double>& coefficients, int factor,
+                            const std::function<void(const float*, int)>& write) {
+    const int block_frames = 4096;
+    int channels = wav.channel_count();
+    sf_count_t frames = wav.frame_count();
+    freqcomp::Decimator<float> decimator(coefficients, factor, channels);
+    std::vector<float> output((size_t) decimator.max_output(block_frames) * channels);
+    std::vector<float> coeffs_f32(coefficients.begin(), coefficients.end());
+    int filter_size = coefficients.size();
+    int block_outputs = std::max(1, block_frames / factor);
+    sf_count_t output_frames = (frames + factor - 1) / factor;
+    const float* samples = wav.float32();
+
+    if (samples && decimator.interleaved_kernel()) {
+        // Mesmo núcleo que o Decimator usaria, em blocos de saídas lidos no próprio mapeamento
+        std::vector<float> window;
+        for (sf_count_t m0 = 0; m0 < output_frames; m0 += block_outputs) {
+            int count = std::min<sf_count_t>(block_outputs, output_frames - m0);
+            // Quadros usados pelo bloco: do primeiro coeficiente da primeira saída até a última saída
+            sf_count_t first = m0 * factor - (filter_size - 1);
+            sf_count_t last = (m0 + count - 1) * factor;
+            const float* span = samples + first * channels;
+            if (first < 0) {
+                window.assign((size_t) (last - first + 1) * channels, 0.0f);
+                std::copy(samples, samples + (last + 1) * channels, window.begin() + (size_t) -first * channels);
+                span = window.data();
+            }
+            freqcomp::fir_decimate_interleaved(coeffs_f32.data(), filter_size, span + (size_t) (filter_size - 1) * channels,
+                                               channels, factor, output.data(), count);
+            write(output.data(), count);
+        }
+        return "núcleo SIMD intercalado";
+    }
+
+    bool pcm = wav.sample_encoding() == MappedWav::PCM_16;
+    for (sf_count_t m0 = 0; m0 < output_frames; m0 += block_outputs) {
+        int count = std::min<sf_count_t>(block_outputs, output_frames - m0);
+        if (pcm) {
+            decimate_view(wav.samples<int16_t>(), coeffs_f32, factor, m0, count, output.data());
+        } else {
+            decimate_view(wav.samples<float>(), coeffs_f32, factor, m0, count, output.data());
+        }
+        write(output.data(), count);
+    }
+    return pcm ? "vista int16" : "vista float";
+}
+
+// Versão de process_audio que lê o WAV mapeado em memória; formatos não suportados usam o libsndfile
+void process_audio_mapped(const char* input_file, const char* output_file, int filter_order, double cutoff_freq, int downsample_factor) {
+    MappedWav wav;
+    if (!wav.open(input_file)) {
+        std::cout << "WAV não é PCM 16 / float 32 mapeável; lendo com libsndfile" << std::endl;
+        process_audio<float>(input_file, output_file, filter_order, cutoff_freq, downsample_factor);
+        return;
+    }
+
+    std::vector<double> fir_coeffs = freqcomp::generate_fir_coefficients(filter_order, cutoff_freq, wav.sample_rate());
 
-    // Salvar o novo arquivo WAV
+    SF_INFO out_sfinfo = SF_INFO();
+    out_sfinfo.samplerate = wav.sample_rate() / downsample_factor;
+    out_sfinfo.channels = wav.channel_count();
+    out_sfinfo.format = SF_FORMAT_WAV | (wav.sample_encoding() == MappedWav::FLOAT_32 ? SF_FORMAT_FLOAT : SF_FORMAT_PCM_16);
     SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
     if (!outfile) {
         std::cerr << "Erro ao salvar arquivo WAV!" << std::endl;
         return;
     }
-    sf_write_double(outfile, downsampled_audio.data(), downsampled_audio.size());
+
+    const char* path = decimate_mapped(wav, fir_coeffs, downsample_factor,
+                                       [&](const float* data, int frames) { write_frames(outfile, data, frames); });
     sf_close(outfile);
 
-    std::cout << "Processamento concluído! Arquivo salvo como " << output_file << std::endl;
+    std::cout << "Processamento concluído (sem cópia, " << path << ")! Arquivo salvo como " << output_file << std::endl;
+}
+
+// Executa um núcleo FIR sobre o sinal inteiro (fator 1), a partir da primeira saída completa
+template <typename Sample, typename Kernel>
+std::vector<Sample> run_fir_kernel(Kernel kernel, const std::vector<Sample>& signal, const std::vector<Sample>& coefficients) {
+    int filter_size = coefficients.size();
+    int count = std::max<int>(0, signal.size() - (filter_size - 1));
+    std::vector<const Sample*> taps(filter_size);
+    for (int k = 0; k < filter_size; k++) {
+        taps[k] = signal.data() + (filter_size - 1 - k);
+    }
+    std::vector<Sample> output(count);
+    kernel(coefficients.data(), taps.data(), filter_size, output.data(), count);
+    return output;
+}
+
+// Compara cada variante SIMD suportada pela CPU com a versão escalar, em double e em float
+bool verify_kernels(const std::vector<double>& input_audio, const std::vector<double>& fir_coeffs) {
+    std::vector<float> input_f32(input_audio.begin(), input_audio.end());
+    std::vector<float> coeffs_f32(fir_coeffs.begin(), fir_coeffs.end());
+    std::vector<double> reference = run_fir_kernel(freqcomp::fir_kernel_scalar<double>, input_audio, fir_coeffs);
+    std::vector<float> reference_f32 = run_fir_kernel(freqcomp::fir_kernel_scalar<float>, input_f32, coeffs_f32);
+
+    std::cout << "Núcleo selecionado: " << freqcomp::selected_fir_kernel().name << std::endl;
+    bool identical = true;
+    for (const freqcomp::FirKernelVariant& variant : freqcomp::fir_kernel_variants()) {
+        if (!variant.supported()) {
+            continue;
+        }
+        bool same = run_fir_kernel(variant.f64, input_audio, fir_coeffs) == reference &&
+                    run_fir_kernel(variant.f32, input_f32, coeffs_f32) == reference_f32;
+        std::cout << "Núcleo " << variant.name << ": " << (same ? "idêntico" : "DIFERENTE") << std::endl;
+        identical = identical && same;
+    }
+    return identical;
+}
+
+// Compara o decimador multicanal (quadros intercalados) com o decimador de um canal aplicado a
+// cada canal separadamente, com 2, 3 e 8 canais sintetizados a partir do sinal
+bool verify_multichannel(const std::vector<double>& input_audio, const std::vector<double>& fir_coeffs) {
+    int frames = input_audio.size();
+    bool identical = true;
+    for (int channels : {2, 3, 8}) {
+        // Canal c: o sinal atrasado de c * 7 amostras e com ganho 1 / (c + 1)
+        std::vector<std::vector<double>> planar(channels, std::vector<double>(frames, 0.0));
+        std::vector<double> interleaved(frames * channels);
+        for (int c = 0; c < channels; c++) {
+            for (int i = c * 7; i < frames; i++) {
+                planar[c][i] = input_audio[i - c * 7] / (c + 1);
+            }
+            for (int i = 0; i < frames; i++) {
+                interleaved[i * channels + c] = planar[c][i];
+            }
+        }
+
+        for (int factor : {1, 3}) {
+            freqcomp::Decimator<double> decimator(fir_coeffs, factor, channels);
+            std::vector<double> output(decimator.max_output(frames) * channels);
+            int produced = 0;
+            for (int offset = 0; offset < frames; offset += 1000) {
+                int count = std::min(1000, frames - offset);
+                produced += decimator.process(interleaved.data() + (size_t) offset * channels, count,
+                                              output.data() + (size_t) produced * channels);
+            }
+
+            bool same = true;
+            for (int c = 0; c < channels; c++) {
+                std::vector<double> reference = freqcomp::polyphase_decimate(planar[c], fir_coeffs, factor);
+                same = same && (int) reference.size() == produced;
+                for (int i = 0; same && i < produced; i++) {
+                    same = output[(size_t) i * channels + c] == reference[i];
+                }
+            }
+            std::cout << channels << " canais, fator " << factor << ": " << (same ? "idêntico" : "DIFERENTE") << std::endl;
+            identical = identical && same;
+        }
+    }
+    return identical;
+}
+
+// Compara a decimação paralela com o decimador em fluxo contínuo aplicado ao arquivo inteiro,
+// com 4 threads e trechos maiores e menores que o filtro
+bool verify_parallel(const std::vector<double>& interleaved, int channels, const std::vector<double>& fir_coeffs) {
+    int frames = interleaved.size() / channels;
+    bool identical = true;
+    for (int factor : {1, 2, 3, 6}) {
+        freqcomp::Decimator<double> decimator(fir_coeffs, factor, channels);
+        std::vector<double> reference((size_t) decimator.max_output(frames) * channels);
+        reference.resize((size_t) decimator.process(interleaved.data(), frames, reference.data()) * channels);
+
+        for (int chunk_frames : {1000, 20}) {
+            std::vector<double> parallel;
+            parallel_decimate<double>(frames, channels, fir_coeffs, factor, 4, chunk_frames,
+                [&](int, sf_count_t first, sf_count_t count, double* data) {
+                    std::copy(interleaved.begin() + first * channels, interleaved.begin() + (first + count) * channels, data);
+                },
+                [&](const double* data, int count) { parallel.insert(parallel.end(), data, data + (size_t) count * channels); });
+            bool same = reference == parallel;
+            std::cout << "Fator " << factor << " (paralelo, trechos de " << chunk_frames << "): "
+                      << (same ? "idêntico" : "DIFERENTE") << std::endl;
+            identical = identical && same;
+        }
+    }
+    return identical;
+}
+
+// Grava um WAV float de 32 bits com o cabeçalho canônico de 44 bytes (região de amostras alinhada)
+bool write_canonical_float_wav(const char* path, const std::vector<float>& interleaved, int channels, int samplerate) {
+    std::ofstream file(path, std::ios::binary);
+    uint32_t data_bytes = interleaved.size() * sizeof(float);
+    auto u32 = [&](uint32_t v) { file.write(reinterpret_cast<const char*>(&v), 4); };
+    auto u16 = [&](uint16_t v) { file.write(reinterpret_cast<const char*>(&v), 2); };
+    file.write("RIFF", 4);
+    u32(36 + data_bytes);
+    file.write("WAVEfmt ", 8);
+    u32(16);
+    u16(3); // WAVE_FORMAT_IEEE_FLOAT
+    u16(channels);
+    u32(samplerate);
+    u32(samplerate * channels * sizeof(float));
+    u16(channels * sizeof(float));
+    u16(32);
+    file.write("data", 4);
+    u32(data_bytes);
+    file.write(reinterpret_cast<const char*>(interleaved.data()), data_bytes);
+    return file.good();
 }
 
-int main() {
+// Compara a leitura do WAV mapeado em memória com process_audio<float> (libsndfile + decimador em
+// fluxo contínuo) nos três caminhos de decimate_mapped: o arquivo original (float desalinhado, vista
+// float), uma cópia de um canal em PCM de 16 bits (vista int16) e uma cópia em float alinhado com 16
+// canais (preenche os registradores de qualquer variante: núcleo SIMD)
+bool verify_mapped(const char* input_file, const std::vector<double>& fir_coeffs) {
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir arquivo WAV!" << std::endl;
+        return false;
+    }
+    std::vector<float> interleaved((size_t) sfinfo.frames * sfinfo.channels);
+    sf_readf_float(infile, interleaved.data(), sfinfo.frames);
+    sf_close(infile);
+
+    // Cópia do primeiro canal em PCM de 16 bits, gravada e relida pelo libsndfile
+    const char* pcm_file = "media/verificacao_pcm16.wav";
+    SF_INFO pcm_info = SF_INFO();
+    pcm_info.samplerate = sfinfo.samplerate;
+    pcm_info.channels = 1;
+    pcm_info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+    std::vector<short> pcm(sfinfo.frames);
+    for (sf_count_t i = 0; i < sfinfo.frames; i++) {
+        pcm[i] = (short) std::max(-32768.0f, std::min(32767.0f, std::round(interleaved[i * sfinfo.channels] * 32768.0f)));
+    }
+    SNDFILE* pcm_out = sf_open(pcm_file, SFM_WRITE, &pcm_info);
+    if (!pcm_out) {
+        std::cerr << "Erro ao salvar arquivo WAV!" << std::endl;
+        return false;
+    }
+    sf_writef_short(pcm_out, pcm.data(), sfinfo.frames);
+    sf_close(pcm_out);
+
+    // 16 canais: o canal c é o primeiro canal do original com ganho 1 / (c + 1)
+    const char* wide_file = "media/verificacao_16canais.wav";
+    const int wide_channels = 16;
+    std::vector<float> wide((size_t) sfinfo.frames * wide_channels);
+    for (sf_count_t i = 0; i < sfinfo.frames; i++) {
+        for (int c = 0; c < wide_channels; c++) {
+            wide[i * wide_channels + c] = interleaved[i * sfinfo.channels] / (c + 1);
+        }
+    }
+    if (!write_canonical_float_wav(wide_file, wide, wide_channels, sfinfo.samplerate)) {
+        std::cerr << "Erro ao salvar arquivo WAV!" << std::endl;
+        std::remove(pcm_file);
+        return false;
+    }
+
+    bool identical = true;
+    for (const char* file : {input_file, pcm_file, wide_file}) {
+        SF_INFO info;
+        SNDFILE* reader = sf_open(file, SFM_READ, &info);
+        if (!reader) {
+            std::cerr << "Erro ao abrir arquivo WAV!" << std::endl;
+            identical = false;
+            continue;
+        }
+        std::vector<float> samples((size_t) info.frames * info.channels);
+        sf_readf_float(reader, samples.data(), info.frames);
+        sf_close(reader);
+
+        MappedWav wav;
+        if (!wav.open(file)) {
+            std::cout << file << ": não mapeável" << std::endl;
+            identical = false;
+            continue;
+        }
+        for (int factor : {1, 2, 3, 6}) {
+            freqcomp::Decimator<float> decimator(fir_coeffs, factor, info.channels);
+            std::vector<float> reference((size_t) decimator.max_output(info.frames) * info.channels);
+            reference.resize((size_t) decimator.process(samples.data(), info.frames, reference.data()) * info.channels);
+
+            std::vector<float> mapped;
+            const char* path = decimate_mapped(wav, fir_coeffs, factor, [&](const float* data, int frames) {
+                mapped.insert(mapped.end(), data, data + (size_t) frames * info.channels);
+            });
+            bool same = reference == mapped;
+            std::cout << "Fator " << factor << " (mmap, " << path << ", " << file
+                      << "): " << (same ? "idêntico" : "DIFERENTE") << std::endl;
+            identical = identical && same;
+        }
+    }
+    std::remove(pcm_file);
+    std::remove(wide_file);
+    return identical;
+}
+
+// Compara os decimadores polifásicos com o caminho original (filtrar e depois decimar)
+bool verify_polyphase(const char* input_file, int filter_order, double cutoff_freq) {
+    SF_INFO sfinfo;
+    SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
+    if (!infile) {
+        std::cerr << "Erro ao abrir arquivo WAV!" << std::endl;
+        return false;
+    }
+    // Quadros intercalados; as verificações de um canal usam o primeiro canal
+    int channels = sfinfo.channels;
+    std::vector<double> interleaved(sfinfo.frames * channels);
+    sf_readf_double(infile, interleaved.data(), sfinfo.frames);
+    sf_close(infile);
+    std::vector<double> input_audio(sfinfo.frames);
+    for (sf_count_t i = 0; i < sfinfo.frames; i++) {
+        input_audio[i] = interleaved[i * channels];
+    }
+
+    std::vector<double> fir_coeffs = freqcomp::generate_fir_coefficients(filter_order, cutoff_freq, sfinfo.samplerate);
+
+    bool identical = true;
+    for (int factor : {1, 2, 3, 6}) {
+        std::vector<double> reference = freqcomp::downsample(freqcomp::apply_fir_filter(input_audio, fir_coeffs), factor);
+        std::vector<double> polyphase = freqcomp::polyphase_decimate(input_audio, fir_coeffs, factor);
+        bool same = reference == polyphase;
+        std::cout << "Fator " << factor << ": " << (same ? "idêntico" : "DIFERENTE") << std::endl;
+        identical = identical && same;
+
+        // O decimador em fluxo contínuo, alimentado com blocos de tamanhos irregulares, deve gerar a mesma saída
+        freqcomp::Decimator<double> decimator(fir_coeffs, factor);
+        std::vector<double> streamed(decimator.max_output(input_audio.size()));
+        const int block_sizes[] = {4096, 1, 37, 1000, 5};
+        size_t offset = 0;
+        int produced = 0;
+        for (int b = 0; offset < input_audio.size(); b = (b + 1) % 5) {
+            int count = std::min<size_t>(block_sizes[b], input_audio.size() - offset);
+            produced += decimator.process(input_audio.data() + offset, count, streamed.data() + produced);
+            offset += count;
+        }
+        streamed.resize(produced);
+        same = reference == streamed;
+        std::cout << "Fator " << factor << " (em blocos): " << (same ? "idêntico" : "DIFERENTE") << std::endl;
+        identical = identical && same;
+    }
+
+    // Todas as verificações rodam, mesmo depois de uma falha, para mostrar cada diferença
+    bool kernels = verify_kernels(input_audio, fir_coeffs);
+    bool multichannel = verify_multichannel(input_audio, fir_coeffs);
+    bool parallel = verify_parallel(interleaved, channels, fir_coeffs);
+    bool mapped = verify_mapped(input_file, fir_coeffs);
+    return identical && kernels && multichannel && parallel && mapped;
+}
+
+int main(int argc, char* argv[]) {
     // Configuração do filtro e do downsampling
     const char* input_wav = "media/audio.wav";
     const char* output_wav = "media/audio_output.wav";
@@ -96,12 +735,40 @@ int main() {
     double cutoff_frequency = 4000.0; // Frequência de corte (Hz)
     int downsample_factor = 2;    // Fator de redução da taxa de amostragem
 
-    // Processa o arquivo WAV
-    process_audio(input_wav, output_wav, filter_order, cutoff_frequency, downsample_factor);
+    // Verificação bit a bit do decimador polifásico contra filtrar e depois decimar
+    if (argc > 1 && std::string(argv[1]) == "--verificar") {
+        return verify_polyphase(input_wav, filter_order, cutoff_frequency) ? 0 : 1;
+    }
+
+    // Divide o arquivo em trechos filtrados em paralelo (por padrão, uma thread por núcleo)
+    if (argc > 1 && std::string(argv[1]) == "--paralelo") {
+        int threads = argc > 2 ? std::stoi(argv[2]) : (int) std::thread::hardware_concurrency();
+        process_audio_parallel<double>(input_wav, output_wav, filter_order, cutoff_frequency, downsample_factor, std::max(1, threads));
+        return 0;
+    }
+
+    // Lê o WAV mapeado em memória, sem cópia para um vetor (em precisão simples)
+    if (argc > 1 && std::string(argv[1]) == "--mmap") {
+        process_audio_mapped(input_wav, output_wav, filter_order, cutoff_frequency, downsample_factor);
+        return 0;
+    }
+
+    // Processa o arquivo WAV (em precisão simples com --float)
+    if (argc > 1 && std::string(argv[1]) == "--float") {
+        process_audio<float>(input_wav, output_wav, filter_order, cutoff_frequency, downsample_factor);
+    } else {
+        process_audio<double>(input_wav, output_wav, filter_order, cutoff_frequency, downsample_factor);
+    }
 
     return 0;
 }
 
 // Run
-// g++ -o example2 example2.cpp -lsndfile -std=c++11
-// ./example2
\ No newline at end of file
+// cmake -S . -B build && cmake --build build
+// ./build/example2
+// (ou, com a biblioteca já compilada: g++ -o example2 example2.cpp -Iinclude -Lbuild -lfreqcomp -lsndfile -lpthread -std=c++11)
+// ./example2 --float       (processa em precisão simples)
+// ./example2 --mmap        (lê o WAV mapeado em memória, direto do cache de páginas e sem cópia: PCM 16 e
+//                           float por vistas tipadas, float alinhado com núcleos SIMD; veja decimate_mapped)
+// ./example2 --paralelo 8  (divide o arquivo em trechos filtrados por 8 threads; saída idêntica à serial)
+// ./example2 --verificar   (confere se o decimador polifásico e os núcleos SIMD são idênticos a filtrar e decimar)
\ No newline at end of file
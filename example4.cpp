@@ -1,14 +1,130 @@
 // Capturar áudio do microfone e reproduzir em tempo real
 
 #include <gst/gst.h>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <unistd.h>
+
+// ---- Instrumentação de latência e jitter ----
+
+// Histograma, estatísticas por elemento, probes, impressão e sinais, comuns aos exemplos 4 e 5
+#include "common/latency_stats.h"
+
+StageStats stats_convert("audioconvert");
+StageStats stats_resample("audioresample");
+
+static void print_all_stats() {
+    std::cout << "---- Latência e jitter ----" << std::endl;
+    print_stats(stats_convert);
+    print_stats(stats_resample);
+}
+
+// ---- Modo de baixa latência ----
+
+// Buffer do dispositivo de áudio, em microssegundos: buffer-time é o tamanho total e latency-time o
+// de cada período (propriedades de GstAudioBaseSrc e GstAudioBaseSink)
+struct DeviceBuffering {
+    gint64 buffer_time_us;
+    gint64 latency_time_us;
+};
+
+// autoaudiosrc e autoaudiosink só criam o elemento real (pulsesrc, alsasink...) ao mudar de estado,
+// então cada um é configurado quando entra no pipeline
+static void on_deep_element_added(GstBin *bin, GstBin *sub_bin, GstElement *element, gpointer user_data) {
+    const DeviceBuffering *buffering = static_cast<const DeviceBuffering*>(user_data);
+    GObjectClass *klass = G_OBJECT_GET_CLASS(element);
+    if (g_object_class_find_property(klass, "buffer-time") && g_object_class_find_property(klass, "latency-time")) {
+        g_object_set(element, "buffer-time", buffering->buffer_time_us, "latency-time", buffering->latency_time_us, NULL);
+        std::cout << GST_ELEMENT_NAME(element) << ": buffer de " << buffering->buffer_time_us / 1000.0 << " ms em períodos de "
+                  << buffering->latency_time_us / 1000.0 << " ms" << std::endl;
+    }
+}
+
+// Latência mínima informada pela consulta LATENCY em um pad (soma da fonte e dos elementos anteriores)
+static bool query_pad_latency(GstPad *pad, GstClockTime *latency) {
+    GstQuery *query = gst_query_new_latency();
+    bool ok = gst_pad_query(pad, query);
+    if (ok) {
+        gboolean live;
+        GstClockTime min_latency, max_latency;
+        gst_query_parse_latency(query, &live, &min_latency, &max_latency);
+        *latency = min_latency;
+    }
+    gst_query_unref(query);
+    return ok;
+}
+
+// Atraso algorítmico do audioresample (latência consultada na saída menos a da entrada, em amostras
+// da taxa de entrada) e a latência acumulada até ele. Retorna a latência acumulada, ou
+// GST_CLOCK_TIME_NONE se a consulta falhar.
+static GstClockTime report_resampler_delay(GstElement *resample) {
+    GstPad *sink_pad = gst_element_get_static_pad(resample, "sink");
+    GstPad *src_pad = gst_element_get_static_pad(resample, "src");
+    GstPad *upstream = gst_pad_get_peer(sink_pad);
+    GstCaps *caps = gst_pad_get_current_caps(sink_pad);
+
+    gint rate = 0;
+    if (caps) {
+        gst_structure_get_int(gst_caps_get_structure(caps, 0), "rate", &rate);
+        gst_caps_unref(caps);
+    }
+
+    GstClockTime before = 0, after = GST_CLOCK_TIME_NONE;
+    if (upstream && rate > 0 && query_pad_latency(upstream, &before) && query_pad_latency(src_pad, &after)) {
+        GstClockTime delay = after > before ? after - before : 0;
+        std::cout << "Atraso do filtro de reamostragem: " << gst_util_uint64_scale_round(delay, rate, GST_SECOND)
+                  << " amostras a " << rate << " Hz (" << delay / 1e6 << " ms)" << std::endl;
+        std::cout << "Latência da fonte e dos filtros: " << after / 1e6 << " ms" << std::endl;
+    } else {
+        std::cerr << "Erro ao consultar a latência do audioresample!" << std::endl;
+        after = GST_CLOCK_TIME_NONE;
+    }
+
+    if (upstream) gst_object_unref(upstream);
+    gst_object_unref(sink_pad);
+    gst_object_unref(src_pad);
+    return after;
+}
 
 int main(int argc, char *argv[]) {
     gst_init(&argc, &argv); // Inicializa o GStreamer
 
+    // Argumentos: [intervalo_s] [--baixa-latencia] [--buffer-ms N] [--periodo-ms N]
+    // O intervalo (padrão 10 s) é o das impressões das estatísticas. O modo de baixa latência
+    // (implícito com --buffer-ms ou --periodo-ms) reduz o buffer dos dispositivos de áudio e usa o
+    // filtro mais curto do audioresample, com o menor atraso de grupo.
+    int interval = 10;
+    bool low_latency = false;
+    DeviceBuffering buffering = {4000, 1000};
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--baixa-latencia") {
+            low_latency = true;
+        } else if (arg == "--buffer-ms" && i + 1 < argc) {
+            buffering.buffer_time_us = (gint64) (std::atof(argv[++i]) * 1000);
+            low_latency = true;
+        } else if (arg == "--periodo-ms" && i + 1 < argc) {
+            buffering.latency_time_us = (gint64) (std::atof(argv[++i]) * 1000);
+            low_latency = true;
+        } else if (i == 1 && arg.find_first_not_of("0123456789") == std::string::npos) {
+            interval = std::atoi(argv[i]);
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [intervalo_s] [--baixa-latencia] [--buffer-ms N] [--periodo-ms N]\n";
+            return 1;
+        }
+    }
+    if (interval < 1) interval = 10;
+    if (buffering.latency_time_us < 1 || buffering.buffer_time_us < 2 * buffering.latency_time_us) {
+        std::cerr << "Erro: o buffer precisa ter pelo menos dois períodos!" << std::endl;
+        return -1;
+    }
+
     // Criação do pipeline para capturar áudio e reamostrar
     GstElement *pipeline = gst_parse_launch(
-        "autoaudiosrc ! audioconvert ! audioresample ! "
+        "autoaudiosrc ! audioconvert name=convert ! audioresample name=resample ! "
         "capsfilter caps=audio/x-raw,rate=16000 ! "
         "autoaudiosink", 
         NULL);
@@ -18,23 +134,60 @@ int main(int argc, char *argv[]) {
         return -1;
     }
 
+    // Probes antes e depois da reamostragem
+    GstElement *convert = gst_bin_get_by_name(GST_BIN(pipeline), "convert");
+    GstElement *resample = gst_bin_get_by_name(GST_BIN(pipeline), "resample");
+    instrument_element(convert, &stats_convert);
+    instrument_element(resample, &stats_resample);
+    gst_object_unref(convert);
+
+    if (low_latency) {
+        // quality=0: o filtro sinc mais curto do audioresample, com o menor atraso de grupo
+        g_object_set(resample, "quality", 0, NULL);
+        g_signal_connect(pipeline, "deep-element-added", G_CALLBACK(on_deep_element_added), &buffering);
+    }
+
+    std::signal(SIGUSR1, on_signal);
+    std::signal(SIGINT, on_signal);
+
     // Inicia o pipeline
     GstStateChangeReturn ret = gst_element_set_state(pipeline, GST_STATE_PLAYING);
     if (ret == GST_STATE_CHANGE_FAILURE) {
         std::cerr << "Erro ao executar o pipeline!" << std::endl;
+        gst_object_unref(resample);
         gst_object_unref(pipeline);
         return -1;
     }
 
-    std::cout << "Capturando e processando áudio em tempo real... Pressione Ctrl+C para sair." << std::endl;
+    // Com o pipeline em PLAYING, informa o atraso do filtro e a latência total estimada
+    if (gst_element_get_state(pipeline, NULL, NULL, 5 * GST_SECOND) == GST_STATE_CHANGE_SUCCESS) {
+        GstClockTime latency = report_resampler_delay(resample);
+        if (low_latency && GST_CLOCK_TIME_IS_VALID(latency)) {
+            double total_ms = latency / 1e6 + buffering.buffer_time_us / 1000.0;
+            std::cout << "Latência total estimada (com o buffer de saída): " << total_ms << " ms"
+                      << (total_ms <= 10 ? "" : " (acima da meta de 10 ms)") << std::endl;
+        }
+    }
+    gst_object_unref(resample);
+
+    std::cout << "Capturando e processando áudio em tempo real... Pressione Ctrl+C para sair (kill -USR1 " << getpid() << " imprime as estatísticas)." << std::endl;
 
-    // Loop para manter a execução até o usuário interromper (Ctrl+C)
+    // A cada "interval" segundos, ou com kill -USR1, imprime as estatísticas
     GstBus *bus = gst_element_get_bus(pipeline);
-    GstMessage *msg;
-    while ((msg = gst_bus_timed_pop_filtered(bus, GST_CLOCK_TIME_NONE,
-                                             static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS)))) {
-        gst_message_unref(msg);
-        break;
+    std::chrono::steady_clock::time_point last_dump = std::chrono::steady_clock::now();
+    while (!stop_requested) {
+        GstMessage *msg = gst_bus_timed_pop_filtered(bus, 100 * GST_MSECOND,
+                                                     static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+        if (msg) {
+            gst_message_unref(msg);
+            break;
+        }
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (dump_requested || now - last_dump >= std::chrono::seconds(interval)) {
+            dump_requested = 0;
+            last_dump = now;
+            print_all_stats();
+        }
     }
 
     // Libera recursos
@@ -42,13 +195,16 @@ int main(int argc, char *argv[]) {
     gst_object_unref(pipeline);
     gst_object_unref(bus);
 
+    print_all_stats();
     std::cout << "Processo finalizado." << std::endl;
     return 0;
 }
 
 // Example:
 // gst-launch-1.0 autoaudiosrc ! audioconvert ! audioresample ! "audio/x-raw,rate=16000" ! autoaudiosink
+// gst-launch-1.0 pulsesrc buffer-time=4000 latency-time=1000 ! audioconvert ! audioresample quality=0 ! "audio/x-raw,rate=16000" ! pulsesink buffer-time=4000 latency-time=1000
 
 // Run
 // g++ -o example4 example4.cpp `pkg-config --cflags --libs gstreamer-1.0` -std=c++11
-// ./example4
\ No newline at end of file
+// ./example4 [intervalo_s]
+// ./example4 --baixa-latencia --buffer-ms 4 --periodo-ms 1   (meta de voz: menos de 10 ms no total)
\ No newline at end of file
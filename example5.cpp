@@ -1,5 +1,24 @@
 #include <gst/gst.h>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <unistd.h>
+
+// ---- Instrumentação de latência e jitter ----
+
+// Histograma, estatísticas por elemento, probes, impressão e sinais, comuns aos exemplos 4 e 5
+#include "common/latency_stats.h"
+
+StageStats stats_convert("audioconvert");
+StageStats stats_resample("audioresample");
+
+static void print_all_stats() {
+    std::cout << "---- Latência e jitter ----" << std::endl;
+    print_stats(stats_convert);
+    print_stats(stats_resample);
+}
 
 // Callback para capturar os buffers
 static GstPadProbeReturn buffer_probe_callback(GstPad *pad, GstPadProbeInfo *info, gpointer user_data) {
@@ -51,6 +70,11 @@ int main(int argc, char *argv[]) {
         return -1;
     }
 
+    // Latência, jitter e tempo de processamento antes e depois da reamostragem (antes dos probes de
+    // impressão, para o tempo de processamento não incluir a escrita no console)
+    instrument_element(convert, &stats_convert);
+    instrument_element(resample, &stats_resample);
+
     // Adicionar probe antes da reamostragem (Áudio Original)
     GstPad *pad_original = gst_element_get_static_pad(convert, "src");
     if (pad_original) {
@@ -65,17 +89,32 @@ int main(int argc, char *argv[]) {
         gst_object_unref(pad_processado);
     }
 
+    // Intervalo entre as impressões das estatísticas, em segundos (padrão 10)
+    int interval = argc > 1 ? std::atoi(argv[1]) : 10;
+    if (interval < 1) interval = 10;
+    std::signal(SIGUSR1, on_signal);
+    std::signal(SIGINT, on_signal);
+
     // Iniciar o pipeline
     gst_element_set_state(pipeline, GST_STATE_PLAYING);
-    std::cout << "Capturando e processando áudio em tempo real... Pressione Ctrl+C para parar." << std::endl;
+    std::cout << "Capturando e processando áudio em tempo real... Pressione Ctrl+C para parar (kill -USR1 " << getpid() << " imprime as estatísticas)." << std::endl;
 
-    // Loop para manter o programa rodando
+    // A cada "interval" segundos, ou com kill -USR1, imprime as estatísticas
     GstBus *bus = gst_element_get_bus(pipeline);
-    GstMessage *msg;
-    while ((msg = gst_bus_timed_pop_filtered(bus, GST_CLOCK_TIME_NONE,
-                                             static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS)))) {
-        gst_message_unref(msg);
-        break;
+    std::chrono::steady_clock::time_point last_dump = std::chrono::steady_clock::now();
+    while (!stop_requested) {
+        GstMessage *msg = gst_bus_timed_pop_filtered(bus, 100 * GST_MSECOND,
+                                                     static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+        if (msg) {
+            gst_message_unref(msg);
+            break;
+        }
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (dump_requested || now - last_dump >= std::chrono::seconds(interval)) {
+            dump_requested = 0;
+            last_dump = now;
+            print_all_stats();
+        }
     }
 
     // Finalizar
@@ -83,6 +122,7 @@ int main(int argc, char *argv[]) {
     gst_object_unref(bus);
     gst_object_unref(pipeline);
 
+    print_all_stats();
     std::cout << "Processamento finalizado." << std::endl;
     return 0;
 }
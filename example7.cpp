@@ -1,39 +1,18 @@
 #include <gst/gst.h>
+#include <atomic>
+#include <csignal>
+#include <functional>
 #include <iostream>
-#include <fstream>
+#include <thread>
 
-// Arquivos para armazenar os dados
-std::ofstream arquivo_original("media/audio_original.raw", std::ios::binary);
-std::ofstream arquivo_processado("media/audio_processado.raw", std::ios::binary);
-
-// Callback para capturar os buffers
-static GstPadProbeReturn buffer_probe_callback(GstPad *pad, GstPadProbeInfo *info, gpointer user_data) {
-    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
-    if (!buffer) return GST_PAD_PROBE_OK;
-
-    GstMapInfo map;
-    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
-        std::string label = static_cast<char*>(user_data);
-        std::cout << label << " - Tamanho do buffer: " << map.size << " bytes" << std::endl;
-
-        // Exibir os primeiros 10 bytes para depuração
-        std::cout << label << " - Dados: ";
-        for (gsize i = 0; i < map.size && i < 10; i++) {
-            std::cout << (int) map.data[i] << " ";
-        }
-        std::cout << std::endl;
-
-        // Salvar os dados no arquivo correspondente
-        if (label == "ORIGINAL") {
-            arquivo_original.write(reinterpret_cast<const char*>(map.data), map.size);
-        } else if (label == "PROCESSADO") {
-            arquivo_processado.write(reinterpret_cast<const char*>(map.data), map.size);
-        }
+// Fila SPSC, probe e thread de gravação, comuns aos exemplos 6 e 7
+#include "common/probe_capture.h"
 
-        gst_buffer_unmap(buffer, &map);
-    }
-    return GST_PAD_PROBE_OK;
-}
+// Arquivos para armazenar os dados
+WriterWakeup acordar_gravador;
+Capture captura_original("ORIGINAL", "media/audio_original.raw", acordar_gravador);
+Capture captura_processada("PROCESSADO", "media/audio_processado.raw", acordar_gravador);
+std::atomic<bool> capturando(true);
 
 int main(int argc, char *argv[]) {
     gst_init(&argc, &argv);
@@ -66,28 +45,33 @@ int main(int argc, char *argv[]) {
     // Adicionar probe antes da reamostragem (Áudio Original)
     GstPad *pad_original = gst_element_get_static_pad(convert, "src");
     if (pad_original) {
-        gst_pad_add_probe(pad_original, GST_PAD_PROBE_TYPE_BUFFER, buffer_probe_callback, (gpointer) "ORIGINAL", nullptr);
+        gst_pad_add_probe(pad_original, GST_PAD_PROBE_TYPE_BUFFER, buffer_probe_callback, &captura_original, nullptr);
         gst_object_unref(pad_original);
     }
 
     // Adicionar probe depois da reamostragem (Áudio Processado)
     GstPad *pad_processado = gst_element_get_static_pad(resample, "src");
     if (pad_processado) {
-        gst_pad_add_probe(pad_processado, GST_PAD_PROBE_TYPE_BUFFER, buffer_probe_callback, (gpointer) "PROCESSADO", nullptr);
+        gst_pad_add_probe(pad_processado, GST_PAD_PROBE_TYPE_BUFFER, buffer_probe_callback, &captura_processada, nullptr);
         gst_object_unref(pad_processado);
     }
 
-    // Iniciar o pipeline
+    // Iniciar a thread de gravação e o pipeline
+    std::thread gravador(writer_thread, std::ref(captura_original), std::ref(captura_processada), std::cref(capturando),
+                         std::ref(acordar_gravador));
+    std::signal(SIGINT, on_signal);
     gst_element_set_state(pipeline, GST_STATE_PLAYING);
     std::cout << "Capturando e processando áudio... Pressione Ctrl+C para parar." << std::endl;
 
-    // Loop para manter o programa rodando
+    // Loop para manter o programa rodando até o fim do fluxo, um erro ou Ctrl+C
     GstBus *bus = gst_element_get_bus(pipeline);
-    GstMessage *msg;
-    while ((msg = gst_bus_timed_pop_filtered(bus, GST_CLOCK_TIME_NONE,
-                                             static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS)))) {
-        gst_message_unref(msg);
-        break;
+    while (!stop_requested) {
+        GstMessage *msg = gst_bus_timed_pop_filtered(bus, 100 * GST_MSECOND,
+                                                     static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+        if (msg) {
+            gst_message_unref(msg);
+            break;
+        }
     }
 
     // Finalizar
@@ -95,9 +79,18 @@ int main(int argc, char *argv[]) {
     gst_object_unref(bus);
     gst_object_unref(pipeline);
 
+    // Sem o pipeline não chegam mais buffers: grava o que restou nas filas e encerra a thread
+    capturando.store(false, std::memory_order_release);
+    acordar_gravador.signal();
+    gravador.join();
+    unsigned long dropped = captura_original.dropped.load() + captura_processada.dropped.load();
+    if (dropped > 0) {
+        std::cerr << "Aviso: " << dropped << " buffers não foram gravados (fila cheia)" << std::endl;
+    }
+
     // Fechar os arquivos
-    arquivo_original.close();
-    arquivo_processado.close();
+    captura_original.file.close();
+    captura_processada.file.close();
 
     std::cout << "Processamento finalizado. Arquivos gerados: audio_original.raw e audio_processado.raw" << std::endl;
     return 0;
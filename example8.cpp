@@ -2,48 +2,12 @@
 #include <vector>
 #include <cmath>
 #include <sndfile.h>
-#include <fftw3.h>
 #include <fstream>
+#include <string>
 
-#define PI 3.14159265358979323846
-
-// Aplicação da FFT para análise de frequência
-std::vector<double> computeFFT(const std::vector<double>& signal) {
-    int N = signal.size();
-    fftw_complex *in, *out;
-    fftw_plan p;
-
-    in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-
-    for (int i = 0; i < N; i++) {
-        in[i][0] = signal[i];  // Parte real
-        in[i][1] = 0.0;        // Parte imaginária
-    }
-
-    p = fftw_plan_dft_1d(N, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
-    fftw_execute(p);
-
-    std::vector<double> spectrum(N);
-    for (int i = 0; i < N; i++) {
-        spectrum[i] = sqrt(out[i][0] * out[i][0] + out[i][1] * out[i][1]); // Módulo da FFT
-    }
-
-    fftw_destroy_plan(p);
-    fftw_free(in);
-    fftw_free(out);
-
-    return spectrum;
-}
-
-// Função de downsampling
-std::vector<double> downsample(const std::vector<double>& signal, int factor) {
-    std::vector<double> downsampled;
-    for (size_t i = 0; i < signal.size(); i += factor) {
-        downsampled.push_back(signal[i]);
-    }
-    return downsampled;
-}
+// Reamostragem racional e FFT (com o cache de planos FFTW) da libfreqcomp
+#include "freqcomp/filter.h"
+#include "freqcomp/spectrum.h"
 
 int main(int argc, char* argv[]) {
     if (argc != 4) {
@@ -55,6 +19,9 @@ int main(int argc, char* argv[]) {
     int target_frequency = std::stoi(argv[2]);
     const char* output_file = argv[3];
 
+    // Planos FFTW ajustados em execuções anteriores
+    freqcomp::load_fft_wisdom();
+
     // Abrir arquivo WAV
     SF_INFO sfinfo;
     SNDFILE* infile = sf_open(input_file, SFM_READ, &sfinfo);
@@ -66,33 +33,39 @@ int main(int argc, char* argv[]) {
     int sample_rate = sfinfo.samplerate;
     int num_samples = sfinfo.frames;
     int num_channels = sfinfo.channels;
-    int downsample_factor = sample_rate / target_frequency;
 
-    std::vector<double> samples(num_samples);
-    sf_read_double(infile, samples.data(), num_samples);
+    // Ler todos os canais (quadros intercalados) e separar um vetor por canal
+    std::vector<double> frames(num_samples * num_channels);
+    sf_readf_double(infile, frames.data(), num_samples);
     sf_close(infile);
+    std::vector<std::vector<double>> channels = freqcomp::deinterleave(frames, num_channels);
 
-    // Aplicar FFT antes do downsampling
-    std::vector<double> original_fft = computeFFT(samples);
+    // Aplicar FFT antes do downsampling (primeiro canal)
+    std::vector<double> original_fft = freqcomp::magnitude_spectrum(freqcomp::computeFFT(channels[0]), channels[0].size());
 
-    // Aplicar downsampling
-    std::vector<double> downsampled_samples = downsample(samples, downsample_factor);
+    // Reamostrar cada canal para a taxa de destino (razão racional L/M)
+    std::vector<std::vector<double>> resampled(num_channels);
+    for (int c = 0; c < num_channels; c++) {
+        resampled[c] = freqcomp::resample_rational(channels[c], sample_rate, target_frequency);
+    }
+    std::vector<double> downsampled_samples = freqcomp::interleave(resampled);
+    int output_frames = resampled[0].size();
 
     // Salvar novo arquivo WAV
     SF_INFO out_sfinfo = sfinfo;
     out_sfinfo.samplerate = target_frequency;
-    out_sfinfo.frames = downsampled_samples.size();
+    out_sfinfo.frames = output_frames;
     SNDFILE* outfile = sf_open(output_file, SFM_WRITE, &out_sfinfo);
     if (!outfile) {
         std::cerr << "Erro ao criar o arquivo WAV de saída!\n";
         return 1;
     }
 
-    sf_write_double(outfile, downsampled_samples.data(), downsampled_samples.size());
+    sf_writef_double(outfile, downsampled_samples.data(), output_frames);
     sf_close(outfile);
 
-    // Aplicar FFT depois do downsampling
-    std::vector<double> processed_fft = computeFFT(downsampled_samples);
+    // Aplicar FFT depois do downsampling (primeiro canal)
+    std::vector<double> processed_fft = freqcomp::magnitude_spectrum(freqcomp::computeFFT(resampled[0]), resampled[0].size());
 
     // Salvar FFTs para análise no Python
     std::ofstream fft_original("media/fft_original.dat");
@@ -103,6 +76,12 @@ int main(int argc, char* argv[]) {
     for (const auto& val : processed_fft) fft_processed << "\n";
     fft_processed.close();
 
+    freqcomp::save_fft_wisdom();
+
     std::cout << "Processamento concluído! Arquivo de saída: " << output_file << "\n";
     return 0;
 }
+
+// Run
+// cmake -S . -B build && cmake --build build
+// ./build/example8 media/audio.wav 16000 media/audio_output.wav
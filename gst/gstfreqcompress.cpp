@@ -0,0 +1,565 @@
+// Elemento freqcompress: GstBaseTransform que reamostra buffers de áudio com a libfreqcomp.
+// A taxa de saída vem da propriedade target-rate ou, com target-rate = 0, do que o elemento
+// seguinte aceitar (como audioresample seguido de capsfilter). Razões com fator de decimação
+// inteiro usam o Decimator (polifásico, núcleos SIMD escolhidos pelo CPUID); as demais, o
+// Resampler racional. Taxas iguais nos dois lados deixam o elemento em modo passthrough.
+
+#include "gstfreqcompress.h"
+
+#include <gst/audio/audio.h>
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+#include "freqcomp/freqcomp.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_freqcompress_debug);
+#define GST_CAT_DEFAULT gst_freqcompress_debug
+
+namespace {
+
+// Motor de reamostragem do formato negociado; entrada e saída são quadros intercalados
+class Engine {
+public:
+    virtual ~Engine() {}
+    virtual size_t max_output(size_t frames) const = 0;
+    virtual size_t process(const void* input, size_t frames, void* output) = 0;
+    virtual size_t flush(void* output) = 0; // Saídas ainda pendentes no fim do fluxo
+    virtual double latency() const = 0;     // Em quadros da taxa de entrada
+    virtual void reset() = 0;
+};
+
+// O atraso de grupo é compensado como no Resampler: a saída m fica alinhada com o quadro de
+// entrada m * factor (a saída do filtro no quadro m * factor + delay, com delay = ordem / 2 em
+// quadros inteiros). Zeros iniciais acertam a fase do decimador com delay, as primeiras saídas
+// (ainda antes do sinal) são descartadas e flush completa o fim com delay quadros nulos.
+template <typename Sample>
+class DecimatorEngine : public Engine {
+public:
+    DecimatorEngine(const std::vector<double>& coefficients, int factor, int channels)
+        : decimator(coefficients, factor, channels), factor(factor), channels(channels), delay((int) (coefficients.size() - 1) / 2),
+          lead_in((factor - delay % factor) % factor), zeros((size_t) std::max(delay, lead_in) * channels, Sample(0)),
+          scratch((size_t) decimator.max_output(lead_in) * channels) {
+        start();
+    }
+
+    size_t max_output(size_t frames) const override { return decimator.max_output((int) frames + delay); }
+    size_t process(const void* input, size_t frames, void* output) override {
+        Sample* out = static_cast<Sample*>(output);
+        return drop_skipped(out, decimator.process(static_cast<const Sample*>(input), (int) frames, out));
+    }
+    size_t flush(void* output) override {
+        Sample* out = static_cast<Sample*>(output);
+        size_t produced = drop_skipped(out, decimator.process(zeros.data(), delay, out));
+        start();
+        return produced;
+    }
+    double latency() const override { return delay; }
+    void reset() override {
+        decimator.reset();
+        start();
+    }
+
+private:
+    // Linha de atraso zerada mais lead_in zeros: as saídas do decimador caem em m * factor + delay
+    void start() {
+        skip = (delay + lead_in) / factor - decimator.process(zeros.data(), lead_in, scratch.data());
+    }
+
+    // Tira do início do bloco as saídas que ainda precedem o primeiro quadro de entrada
+    size_t drop_skipped(Sample* output, int produced) {
+        int dropped = std::min(skip, produced);
+        skip -= dropped;
+        std::copy(output + (size_t) dropped * channels, output + (size_t) produced * channels, output);
+        return produced - dropped;
+    }
+
+    freqcomp::Decimator<Sample> decimator;
+    int factor;
+    int channels;
+    int delay;                  // Atraso de grupo em quadros de entrada
+    int lead_in;                // Zeros iniciais que põem a fase das saídas em delay (mod factor)
+    std::vector<Sample> zeros;
+    std::vector<Sample> scratch; // Saídas dos zeros iniciais (descartadas)
+    int skip;                   // Saídas a descartar antes da primeira alinhada
+};
+
+template <typename Sample>
+class ResamplerEngine : public Engine {
+public:
+    ResamplerEngine(int input_rate, int output_rate, int channels, int zero_crossings)
+        : resampler(input_rate, output_rate, channels, zero_crossings), channels(channels) {}
+
+    size_t max_output(size_t frames) const override { return resampler.max_output((int) frames); }
+    size_t process(const void* input, size_t frames, void* output) override {
+        return resampler.process(freqcomp::Span<const Sample>(static_cast<const Sample*>(input), frames * channels),
+                                 freqcomp::Span<Sample>(static_cast<Sample*>(output), max_output(frames) * channels));
+    }
+    size_t flush(void* output) override {
+        return resampler.flush(freqcomp::Span<Sample>(static_cast<Sample*>(output), max_output(0) * channels));
+    }
+    double latency() const override { return resampler.latency(); }
+    void reset() override { resampler.reset(); }
+
+private:
+    freqcomp::Resampler<Sample> resampler;
+    size_t channels;
+};
+
+// quality (0 a 10) define os cruzamentos por zero do filtro, 4 * (quality + 1): o padrão 3 dá os
+// 16 de resample_rational. taps diferente de zero fixa o tamanho do filtro no lugar de quality.
+template <typename Sample>
+Engine* create_engine(int input_rate, int output_rate, int channels, int taps, int quality) {
+    int g = freqcomp::gcd(input_rate, output_rate);
+    int L = output_rate / g;
+    int M = input_rate / g;
+    int zero_crossings = 4 * (quality + 1);
+    if (taps > 0) {
+        zero_crossings = std::max(1, (taps - 1) / (2 * std::max(L, M)));
+    }
+    if (L == 1) {
+        int filter_order = taps > 0 ? taps - 1 : 2 * zero_crossings * M;
+        // Pelo banco compartilhado: uma nova negociação de caps não projeta o mesmo filtro de novo
+        const std::vector<double>& coefficients = freqcomp::cached_fir_coefficients(filter_order, 0.45 * output_rate, input_rate);
+        return new DecimatorEngine<Sample>(coefficients, M, channels);
+    }
+    return new ResamplerEngine<Sample>(input_rate, output_rate, channels, zero_crossings);
+}
+
+} // namespace
+
+struct _GstFreqCompress {
+    GstBaseTransform parent;
+
+    // Propriedades (lock do objeto)
+    gint target_rate;
+    gint taps;
+    gint quality;
+
+    // Estado do fluxo, usado pela thread de streaming
+    GstAudioInfo in_info;
+    GstAudioInfo out_info;
+    Engine* engine;          // Trocado com o lock do objeto; transform_size, chamada de outras threads, também o lê com o lock
+    GstClockTime latency;    // Atraso do filtro, lido também pela consulta de latência (lock do objeto)
+    GstClockTime start_time; // PTS do primeiro buffer depois do último recomeço
+    guint64 frames_out;      // Quadros de saída gerados desde start_time
+};
+
+enum {
+    PROP_0,
+    PROP_TARGET_RATE,
+    PROP_TAPS,
+    PROP_QUALITY
+};
+
+#define DEFAULT_TARGET_RATE 0
+#define DEFAULT_TAPS 0
+#define DEFAULT_QUALITY 3
+
+#define FREQCOMPRESS_CAPS GST_AUDIO_CAPS_MAKE("{ " GST_AUDIO_NE(F32) ", " GST_AUDIO_NE(F64) " }")
+
+static GstStaticPadTemplate sink_template =
+    GST_STATIC_PAD_TEMPLATE("sink", GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS(FREQCOMPRESS_CAPS));
+static GstStaticPadTemplate src_template =
+    GST_STATIC_PAD_TEMPLATE("src", GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS(FREQCOMPRESS_CAPS));
+
+G_DEFINE_TYPE(GstFreqCompress, gst_freqcompress, GST_TYPE_BASE_TRANSFORM);
+
+// O motor antigo só é apagado depois de sair do lock: quem o lê com o lock (transform_size) já terminou
+static void gst_freqcompress_replace_engine(GstFreqCompress* self, Engine* engine, GstClockTime latency) {
+    GST_OBJECT_LOCK(self);
+    Engine* old = self->engine;
+    self->engine = engine;
+    self->latency = latency;
+    GST_OBJECT_UNLOCK(self);
+    delete old;
+}
+
+// Recomeça o fluxo: linha de atraso zerada e tempos contados a partir do próximo buffer
+static void gst_freqcompress_restart(GstFreqCompress* self) {
+    if (self->engine) {
+        self->engine->reset();
+    }
+    self->start_time = GST_CLOCK_TIME_NONE;
+    self->frames_out = 0;
+}
+
+static void gst_freqcompress_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(object);
+
+    switch (prop_id) {
+    case PROP_TARGET_RATE:
+        GST_OBJECT_LOCK(self);
+        self->target_rate = g_value_get_int(value);
+        GST_OBJECT_UNLOCK(self);
+        // Renegocia a taxa de saída no próximo buffer
+        gst_pad_mark_reconfigure(GST_BASE_TRANSFORM_SRC_PAD(self));
+        break;
+    case PROP_TAPS:
+        GST_OBJECT_LOCK(self);
+        self->taps = g_value_get_int(value);
+        GST_OBJECT_UNLOCK(self);
+        break;
+    case PROP_QUALITY:
+        GST_OBJECT_LOCK(self);
+        self->quality = g_value_get_int(value);
+        GST_OBJECT_UNLOCK(self);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void gst_freqcompress_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(object);
+
+    GST_OBJECT_LOCK(self);
+    switch (prop_id) {
+    case PROP_TARGET_RATE:
+        g_value_set_int(value, self->target_rate);
+        break;
+    case PROP_TAPS:
+        g_value_set_int(value, self->taps);
+        break;
+    case PROP_QUALITY:
+        g_value_set_int(value, self->quality);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(self);
+}
+
+static void gst_freqcompress_finalize(GObject* object) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(object);
+    delete self->engine;
+    self->engine = NULL;
+    G_OBJECT_CLASS(gst_freqcompress_parent_class)->finalize(object);
+}
+
+// Mesmo formato e número de canais dos dois lados; só a taxa muda. Do lado da saída, a taxa é
+// target-rate quando definida, senão qualquer uma.
+static GstCaps* gst_freqcompress_transform_caps(GstBaseTransform* base, GstPadDirection direction, GstCaps* caps, GstCaps* filter) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+
+    GST_OBJECT_LOCK(self);
+    gint target_rate = self->target_rate;
+    GST_OBJECT_UNLOCK(self);
+
+    GstCaps* result = gst_caps_copy(caps);
+    for (guint i = 0; i < gst_caps_get_size(result); i++) {
+        GstStructure* structure = gst_caps_get_structure(result, i);
+        if (direction == GST_PAD_SINK && target_rate > 0) {
+            gst_structure_set(structure, "rate", G_TYPE_INT, target_rate, NULL);
+        } else {
+            gst_structure_set(structure, "rate", GST_TYPE_INT_RANGE, 1, G_MAXINT, NULL);
+        }
+    }
+
+    if (filter) {
+        GstCaps* intersection = gst_caps_intersect_full(filter, result, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(result);
+        result = intersection;
+    }
+    GST_DEBUG_OBJECT(self, "%" GST_PTR_FORMAT " -> %" GST_PTR_FORMAT, caps, result);
+    return result;
+}
+
+// Entre as taxas possíveis, fica com a mais próxima de target-rate (ou da taxa do outro lado)
+static GstCaps* gst_freqcompress_fixate_caps(GstBaseTransform* base, GstPadDirection direction, GstCaps* caps, GstCaps* othercaps) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+
+    GST_OBJECT_LOCK(self);
+    gint target_rate = self->target_rate;
+    GST_OBJECT_UNLOCK(self);
+
+    if (gst_caps_is_empty(othercaps)) {
+        return othercaps;
+    }
+    othercaps = gst_caps_truncate(othercaps);
+    othercaps = gst_caps_make_writable(othercaps);
+    GstStructure* structure = gst_caps_get_structure(othercaps, 0);
+
+    gint rate;
+    if (direction == GST_PAD_SINK && target_rate > 0) {
+        gst_structure_fixate_field_nearest_int(structure, "rate", target_rate);
+    } else if (gst_structure_get_int(gst_caps_get_structure(caps, 0), "rate", &rate)) {
+        gst_structure_fixate_field_nearest_int(structure, "rate", rate);
+    }
+    return gst_caps_fixate(othercaps);
+}
+
+static gboolean gst_freqcompress_set_caps(GstBaseTransform* base, GstCaps* incaps, GstCaps* outcaps) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+
+    GstAudioInfo in_info, out_info;
+    if (!gst_audio_info_from_caps(&in_info, incaps) || !gst_audio_info_from_caps(&out_info, outcaps)) {
+        GST_ERROR_OBJECT(self, "caps inválidos: %" GST_PTR_FORMAT " -> %" GST_PTR_FORMAT, incaps, outcaps);
+        return FALSE;
+    }
+    if (GST_AUDIO_INFO_FORMAT(&in_info) != GST_AUDIO_INFO_FORMAT(&out_info) ||
+        GST_AUDIO_INFO_CHANNELS(&in_info) != GST_AUDIO_INFO_CHANNELS(&out_info)) {
+        GST_ERROR_OBJECT(self, "formato ou número de canais diferentes: %" GST_PTR_FORMAT " -> %" GST_PTR_FORMAT, incaps, outcaps);
+        return FALSE;
+    }
+
+    GST_OBJECT_LOCK(self);
+    gint taps = self->taps;
+    gint quality = self->quality;
+    GST_OBJECT_UNLOCK(self);
+
+    int input_rate = GST_AUDIO_INFO_RATE(&in_info);
+    int output_rate = GST_AUDIO_INFO_RATE(&out_info);
+    int channels = GST_AUDIO_INFO_CHANNELS(&in_info);
+
+    Engine* engine = NULL;
+    if (input_rate != output_rate) {
+        try {
+            if (GST_AUDIO_INFO_FORMAT(&in_info) == GST_AUDIO_FORMAT_F32) {
+                engine = create_engine<float>(input_rate, output_rate, channels, taps, quality);
+            } else {
+                engine = create_engine<double>(input_rate, output_rate, channels, taps, quality);
+            }
+        } catch (const std::exception& e) {
+            GST_ERROR_OBJECT(self, "erro ao criar o filtro: %s", e.what());
+            return FALSE;
+        }
+    }
+    GstClockTime latency = engine ? (GstClockTime) (engine->latency() * GST_SECOND / input_rate + 0.5) : 0;
+
+    gst_freqcompress_replace_engine(self, engine, latency);
+    self->in_info = in_info;
+    self->out_info = out_info;
+    gst_freqcompress_restart(self);
+
+    GST_INFO_OBJECT(self, "%d -> %d Hz, %d canais, atraso do filtro %" GST_TIME_FORMAT, input_rate, output_rate, channels,
+                    GST_TIME_ARGS(latency));
+
+    // O atraso mudou: a aplicação precisa recalcular a latência do pipeline
+    gst_element_post_message(GST_ELEMENT(self), gst_message_new_latency(GST_OBJECT(self)));
+    return TRUE;
+}
+
+static gboolean gst_freqcompress_transform_size(GstBaseTransform* base, GstPadDirection direction, GstCaps* caps, gsize size,
+                                                GstCaps* othercaps, gsize* othersize) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+
+    GstAudioInfo info, other_info;
+    if (!gst_audio_info_from_caps(&info, caps) || !gst_audio_info_from_caps(&other_info, othercaps)) {
+        return FALSE;
+    }
+    gsize frames = size / GST_AUDIO_INFO_BPF(&info);
+
+    // Pode ser chamada por consultas de alocação em outra thread enquanto set_caps ou stop trocam o
+    // motor: sem o lock, o ponteiro lido poderia já ter sido apagado
+    gboolean have_engine = FALSE;
+    gsize max_frames = 0;
+    if (direction == GST_PAD_SINK) {
+        GST_OBJECT_LOCK(self);
+        if (self->engine) {
+            have_engine = TRUE;
+            max_frames = self->engine->max_output(frames);
+        }
+        GST_OBJECT_UNLOCK(self);
+    }
+
+    if (have_engine) {
+        // O buffer de saída tem espaço para o pior caso; transform o reduz ao que foi gerado
+        *othersize = max_frames * GST_AUDIO_INFO_BPF(&other_info);
+    } else {
+        *othersize = gst_util_uint64_scale_ceil(frames, GST_AUDIO_INFO_RATE(&other_info), GST_AUDIO_INFO_RATE(&info)) *
+                     GST_AUDIO_INFO_BPF(&other_info);
+    }
+    return TRUE;
+}
+
+// Ajusta o tamanho do buffer ao que foi gerado e calcula os tempos a partir dos quadros de saída
+// acumulados, sem arredondamento acumulado entre buffers
+static void gst_freqcompress_stamp(GstFreqCompress* self, GstBuffer* outbuf, size_t produced) {
+    gint rate = GST_AUDIO_INFO_RATE(&self->out_info);
+    gst_buffer_set_size(outbuf, produced * GST_AUDIO_INFO_BPF(&self->out_info));
+
+    GstClockTime begin = gst_util_uint64_scale_int_round(self->frames_out, GST_SECOND, rate);
+    GstClockTime end = gst_util_uint64_scale_int_round(self->frames_out + produced, GST_SECOND, rate);
+    GST_BUFFER_PTS(outbuf) = self->start_time + begin;
+    GST_BUFFER_DTS(outbuf) = GST_CLOCK_TIME_NONE;
+    GST_BUFFER_DURATION(outbuf) = end - begin;
+    GST_BUFFER_OFFSET(outbuf) = self->frames_out;
+    GST_BUFFER_OFFSET_END(outbuf) = self->frames_out + produced;
+    self->frames_out += produced;
+}
+
+static GstFlowReturn gst_freqcompress_transform(GstBaseTransform* base, GstBuffer* inbuf, GstBuffer* outbuf) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+
+    if (!self->engine) {
+        GST_ELEMENT_ERROR(self, CORE, NEGOTIATION, (NULL), ("formato não negociado"));
+        return GST_FLOW_NOT_NEGOTIATED;
+    }
+
+    // Descontinuidade: o histórico do filtro não vale mais; os tempos recomeçam neste buffer
+    if (GST_BUFFER_IS_DISCONT(inbuf) || self->start_time == GST_CLOCK_TIME_NONE) {
+        gst_freqcompress_restart(self);
+        self->start_time = GST_BUFFER_PTS_IS_VALID(inbuf) ? GST_BUFFER_PTS(inbuf) : 0;
+    }
+
+    GstMapInfo in_map, out_map;
+    if (!gst_buffer_map(inbuf, &in_map, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(self, STREAM, FAILED, (NULL), ("erro ao mapear o buffer de entrada"));
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
+        gst_buffer_unmap(inbuf, &in_map);
+        GST_ELEMENT_ERROR(self, STREAM, FAILED, (NULL), ("erro ao mapear o buffer de saída"));
+        return GST_FLOW_ERROR;
+    }
+
+    gsize frames = in_map.size / GST_AUDIO_INFO_BPF(&self->in_info);
+    size_t produced = 0;
+    try {
+        produced = self->engine->process(in_map.data, frames, out_map.data);
+    } catch (const std::exception& e) {
+        gst_buffer_unmap(outbuf, &out_map);
+        gst_buffer_unmap(inbuf, &in_map);
+        GST_ELEMENT_ERROR(self, STREAM, FAILED, (NULL), ("%s", e.what()));
+        return GST_FLOW_ERROR;
+    }
+    gst_buffer_unmap(outbuf, &out_map);
+    gst_buffer_unmap(inbuf, &in_map);
+
+    gst_freqcompress_stamp(self, outbuf, produced);
+    // Buffers curtos podem não completar nenhuma saída (a linha de atraso guarda as amostras)
+    return produced > 0 ? GST_FLOW_OK : GST_BASE_TRANSFORM_FLOW_DROPPED;
+}
+
+// Fim do fluxo: envia as saídas que o motor ainda segurava por causa do atraso de grupo
+static void gst_freqcompress_drain(GstFreqCompress* self) {
+    if (!self->engine || self->start_time == GST_CLOCK_TIME_NONE) {
+        return;
+    }
+    GstBuffer* outbuf = gst_buffer_new_allocate(NULL, self->engine->max_output(0) * GST_AUDIO_INFO_BPF(&self->out_info), NULL);
+    GstMapInfo map;
+    gst_buffer_map(outbuf, &map, GST_MAP_WRITE);
+    size_t produced = self->engine->flush(map.data);
+    gst_buffer_unmap(outbuf, &map);
+
+    if (produced > 0) {
+        gst_freqcompress_stamp(self, outbuf, produced);
+        GstFlowReturn ret = gst_pad_push(GST_BASE_TRANSFORM_SRC_PAD(self), outbuf);
+        if (ret != GST_FLOW_OK) {
+            GST_WARNING_OBJECT(self, "erro ao enviar o fim do sinal: %s", gst_flow_get_name(ret));
+        }
+    } else {
+        gst_buffer_unref(outbuf);
+    }
+    gst_freqcompress_restart(self);
+}
+
+static gboolean gst_freqcompress_sink_event(GstBaseTransform* base, GstEvent* event) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+
+    switch (GST_EVENT_TYPE(event)) {
+    case GST_EVENT_FLUSH_STOP:
+        gst_freqcompress_restart(self);
+        break;
+    case GST_EVENT_EOS:
+        gst_freqcompress_drain(self);
+        break;
+    default:
+        break;
+    }
+    return GST_BASE_TRANSFORM_CLASS(gst_freqcompress_parent_class)->sink_event(base, event);
+}
+
+// Soma o atraso do filtro à latência informada pelos elementos anteriores
+static gboolean gst_freqcompress_query(GstBaseTransform* base, GstPadDirection direction, GstQuery* query) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+
+    gboolean result = GST_BASE_TRANSFORM_CLASS(gst_freqcompress_parent_class)->query(base, direction, query);
+    if (result && direction == GST_PAD_SRC && GST_QUERY_TYPE(query) == GST_QUERY_LATENCY) {
+        gboolean live;
+        GstClockTime min_latency, max_latency;
+        gst_query_parse_latency(query, &live, &min_latency, &max_latency);
+
+        GST_OBJECT_LOCK(self);
+        GstClockTime latency = self->latency;
+        GST_OBJECT_UNLOCK(self);
+
+        min_latency += latency;
+        if (GST_CLOCK_TIME_IS_VALID(max_latency)) {
+            max_latency += latency;
+        }
+        gst_query_set_latency(query, live, min_latency, max_latency);
+    }
+    return result;
+}
+
+static gboolean gst_freqcompress_stop(GstBaseTransform* base) {
+    GstFreqCompress* self = GST_FREQCOMPRESS(base);
+    gst_freqcompress_replace_engine(self, NULL, 0);
+    gst_freqcompress_restart(self);
+    return TRUE;
+}
+
+static void gst_freqcompress_class_init(GstFreqCompressClass* klass) {
+    GObjectClass* gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass* element_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass* transform_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gobject_class->set_property = gst_freqcompress_set_property;
+    gobject_class->get_property = gst_freqcompress_get_property;
+    gobject_class->finalize = gst_freqcompress_finalize;
+
+    g_object_class_install_property(gobject_class, PROP_TARGET_RATE,
+        g_param_spec_int("target-rate", "Taxa de destino",
+                         "Taxa de amostragem da saída em Hz (0 = a que o elemento seguinte aceitar)", 0, G_MAXINT,
+                         DEFAULT_TARGET_RATE, (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(gobject_class, PROP_TAPS,
+        g_param_spec_int("taps", "Coeficientes",
+                         "Número de coeficientes do filtro (0 = definido por quality)", 0, 65535, DEFAULT_TAPS,
+                         (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY)));
+    g_object_class_install_property(gobject_class, PROP_QUALITY,
+        g_param_spec_int("quality", "Qualidade",
+                         "Qualidade do filtro: 4 * (quality + 1) cruzamentos por zero de cada lado", 0, 10, DEFAULT_QUALITY,
+                         (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY)));
+
+    gst_element_class_add_static_pad_template(element_class, &sink_template);
+    gst_element_class_add_static_pad_template(element_class, &src_template);
+    gst_element_class_set_static_metadata(element_class, "Rebaixamento de frequência", "Filter/Converter/Audio",
+                                          "Reamostra áudio com o decimador polifásico e o reamostrador racional da libfreqcomp",
+                                          "freqcomp");
+
+    transform_class->transform_caps = GST_DEBUG_FUNCPTR(gst_freqcompress_transform_caps);
+    transform_class->fixate_caps = GST_DEBUG_FUNCPTR(gst_freqcompress_fixate_caps);
+    transform_class->set_caps = GST_DEBUG_FUNCPTR(gst_freqcompress_set_caps);
+    transform_class->transform_size = GST_DEBUG_FUNCPTR(gst_freqcompress_transform_size);
+    transform_class->transform = GST_DEBUG_FUNCPTR(gst_freqcompress_transform);
+    transform_class->sink_event = GST_DEBUG_FUNCPTR(gst_freqcompress_sink_event);
+    transform_class->query = GST_DEBUG_FUNCPTR(gst_freqcompress_query);
+    transform_class->stop = GST_DEBUG_FUNCPTR(gst_freqcompress_stop);
+    transform_class->passthrough_on_same_caps = TRUE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_freqcompress_debug, "freqcompress", 0, "Rebaixamento de frequência com a libfreqcomp");
+}
+
+static void gst_freqcompress_init(GstFreqCompress* self) {
+    self->target_rate = DEFAULT_TARGET_RATE;
+    self->taps = DEFAULT_TAPS;
+    self->quality = DEFAULT_QUALITY;
+    gst_audio_info_init(&self->in_info);
+    gst_audio_info_init(&self->out_info);
+    self->engine = NULL;
+    self->latency = 0;
+    self->start_time = GST_CLOCK_TIME_NONE;
+    self->frames_out = 0;
+}
+
+static gboolean plugin_init(GstPlugin* plugin) {
+    return gst_element_register(plugin, "freqcompress", GST_RANK_NONE, GST_TYPE_FREQCOMPRESS);
+}
+
+GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, freqcompress, "Rebaixamento de frequência com a libfreqcomp", plugin_init,
+                  FREQCOMP_VERSION, GST_LICENSE_UNKNOWN, "freqcomp", "freqcomp")
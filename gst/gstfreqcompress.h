@@ -0,0 +1,17 @@
+#ifndef GST_FREQCOMPRESS_H
+#define GST_FREQCOMPRESS_H
+
+// Elemento GStreamer "freqcompress": reamostra áudio F32/F64 intercalado com os núcleos da
+// libfreqcomp (Decimator polifásico com SIMD para fatores inteiros, Resampler para razões L/M)
+
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_FREQCOMPRESS (gst_freqcompress_get_type())
+G_DECLARE_FINAL_TYPE(GstFreqCompress, gst_freqcompress, GST, FREQCOMPRESS, GstBaseTransform)
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef FREQCOMP_COEFFICIENT_BANK_H
+#define FREQCOMP_COEFFICIENT_BANK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "freqcomp/filter.h"
+#include "freqcomp/span.h"
+
+namespace freqcomp {
+
+// Configuração padrão com coeficientes calculados pelo compilador (tabelas constexpr, sem sin/cos
+// em tempo de execução). As tabelas são idênticas bit a bit a generate_fir_coefficients com a libm
+// da glibc e long double de 64 bits (x86); "example16 --verificar" confere isso na plataforma atual.
+struct StandardFirTable {
+    int order;
+    double cutoff;
+    double rate;
+    const double* coefficients; // order + 1 coeficientes, janela de Hamming
+};
+
+// Configurações usadas pelos exemplos e pipelines: example1 (31, 500 Hz, 8 kHz), example2/example12
+// (31, 4 kHz, 44,1 kHz), example14 (31, fator 2 a 48 kHz), example13 (63, fator 3 a 48 kHz) e o
+// decimador padrão de freqcompress e example19 (96, fator 3 a 48 kHz)
+Span<const StandardFirTable> standard_fir_tables();
+
+// Tabela padrão da configuração, ou nullptr se não houver (só janela de Hamming)
+const StandardFirTable* find_standard_fir_table(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window = HAMMING);
+
+// Banco de coeficientes memorizado por (ordem, corte, taxa, janela). Cada projeto é calculado uma
+// única vez (ou copiado da tabela padrão) e pode ser gravado em arquivo e recarregado. As entradas
+// nunca são removidas, então as referências devolvidas por get continuam válidas enquanto o banco existir.
+class CoefficientBank {
+public:
+    CoefficientBank();
+
+    // Banco compartilhado pelo processo, usado por Resampler, resample_rational e pelos pipelines
+    static CoefficientBank& instance();
+
+    // Mesmo resultado de generate_fir_coefficients com os mesmos argumentos
+    const std::vector<double>& get(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window = HAMMING);
+
+    // Formato: "FIRB", versão, número de entradas e, por entrada, ordem, corte, taxa, janela e os
+    // ordem + 1 coeficientes em double (ordem de bytes da máquina)
+    bool save(const std::string& path) const;
+
+    // Acrescenta as entradas do arquivo às que já estão no banco (as existentes são mantidas)
+    bool load(const std::string& path);
+
+    size_t size() const;
+    size_t hits() const;
+    size_t misses() const;
+
+    CoefficientBank(const CoefficientBank&) = delete;
+    CoefficientBank& operator=(const CoefficientBank&) = delete;
+
+private:
+    struct Key {
+        int order;
+        double cutoff;
+        double rate;
+        FirWindow window;
+
+        bool operator<(const Key& other) const;
+    };
+
+    static const uint32_t magic = 0x42524946; // "FIRB"
+    static const uint32_t version = 1;
+
+    mutable std::mutex mutex;
+    std::map<Key, std::vector<double>> entries;
+    size_t hit_count;
+    size_t miss_count;
+};
+
+// Coeficientes pelo banco compartilhado: generate_fir_coefficients sem recalcular projetos repetidos
+const std::vector<double>& cached_fir_coefficients(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window = HAMMING);
+
+} // namespace freqcomp
+
+#endif
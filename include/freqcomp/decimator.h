@@ -0,0 +1,66 @@
+#ifndef FREQCOMP_DECIMATOR_H
+#define FREQCOMP_DECIMATOR_H
+
+#include <vector>
+
+#include "freqcomp/span.h"
+
+namespace freqcomp {
+
+// Decimador FIR em fluxo contínuo: recebe o sinal em blocos de qualquer tamanho e mantém a linha
+// de atraso (os últimos filter_size - 1 quadros) entre as chamadas. A memória usada depende só
+// do tamanho do bloco e do filtro, não da duração do sinal. Sample pode ser double ou float.
+// Com mais de um canal, entrada e saída são quadros intercalados; os canais são filtrados juntos,
+// um por posição do registrador SIMD, quando preenchem registradores inteiros, e um de cada vez
+// (separados em componentes polifásicas) nos demais casos. A saída é idêntica bit a bit a
+// polyphase_decimate aplicado a cada canal, qualquer que seja a divisão em blocos.
+template <typename Sample>
+class Decimator {
+public:
+    Decimator(const std::vector<double>& coefficients, int factor, int channels = 1);
+
+    // Volta ao estado inicial (linha de atraso zerada, como um sinal nulo antes do início)
+    void reset();
+
+    // Recomeça no meio de um sinal: os "count" quadros anteriores ao próximo bloco (no máximo
+    // filter_size - 1, senão lança std::invalid_argument) ocupam o fim da linha de atraso no lugar dos zeros
+    void prime(const Sample* frames, int count);
+
+    // Número máximo de quadros de saída gerados por um bloco de "count" quadros
+    int max_output(int count) const { return count / factor + 1; }
+
+    // Atraso de grupo do filtro, em quadros da taxa de entrada ((filter_size - 1) / 2, fase linear)
+    double latency() const { return (coefficients.size() - 1) / 2.0; }
+
+    int decimation_factor() const { return factor; }
+    int channel_count() const { return channels; }
+
+    // true quando os canais preenchem os registradores e o núcleo lê direto dos quadros intercalados
+    // (fir_decimate_interleaved); false quando cada canal é separado em componentes polifásicas
+    bool interleaved_kernel() const { return interleaved; }
+
+    // Filtra e decima "count" quadros; grava as saídas em output e retorna quantos quadros foram gerados
+    int process(const Sample* input, int count, Sample* output);
+
+    // Mesma operação sobre visões de amostras intercaladas. output precisa de espaço para
+    // max_output(quadros de entrada) quadros; caso contrário lança std::length_error.
+    size_t process(Span<const Sample> input, Span<Sample> output);
+
+private:
+    std::vector<Sample> coefficients;
+    int factor;
+    int channels;
+    bool interleaved;                        // Núcleo multicanal direto sobre os quadros intercalados
+    std::vector<Sample> history;             // Linha de atraso + bloco atual (quadros intercalados)
+    int next_output;                         // Quadro de history da próxima saída
+    std::vector<std::vector<Sample>> phases; // Componentes polifásicas reaproveitadas entre blocos (um canal)
+    std::vector<const Sample*> taps;
+    std::vector<Sample> channel_output;      // Saídas de um canal antes de intercalar
+};
+
+extern template class Decimator<double>;
+extern template class Decimator<float>;
+
+} // namespace freqcomp
+
+#endif
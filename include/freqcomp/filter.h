@@ -0,0 +1,37 @@
+#ifndef FREQCOMP_FILTER_H
+#define FREQCOMP_FILTER_H
+
+#include <vector>
+
+namespace freqcomp {
+
+// Janelas aplicadas ao sinc no projeto dos filtros
+enum FirWindow { HAMMING = 0, HANN = 1, BLACKMAN = 2 };
+
+// Coeficientes FIR passa-baixa (sinc com janela, Hamming por padrão), filter_order + 1 coeficientes
+std::vector<double> generate_fir_coefficients(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window = HAMMING);
+
+// Filtra o sinal inteiro (linha de atraso inicial zerada); mesma saída que o sinal de entrada
+std::vector<double> apply_fir_filter(const std::vector<double>& input_signal, const std::vector<double>& coefficients);
+
+// Mantém uma amostra a cada "factor" (sem filtragem)
+std::vector<double> downsample(const std::vector<double>& signal, int factor);
+
+// Filtra e decima calculando só as amostras mantidas; idêntico bit a bit a
+// downsample(apply_fir_filter(sinal, coeficientes), factor)
+std::vector<double> polyphase_decimate(const std::vector<double>& input_signal, const std::vector<double>& coefficients, int factor);
+
+// Reamostragem racional output_rate / input_rate (reduzida para L/M) com banco polifásico e
+// compensação do atraso de grupo; gera ceil(N * L / M) amostras
+std::vector<double> resample_rational(const std::vector<double>& signal, int input_rate, int output_rate, int zero_crossings = 16);
+
+// Máximo divisor comum, usado para reduzir a razão entre as taxas
+int gcd(int a, int b);
+
+// Conversão entre quadros intercalados e um vetor por canal
+std::vector<std::vector<double>> deinterleave(const std::vector<double>& frames, int channels);
+std::vector<double> interleave(const std::vector<std::vector<double>>& planar);
+
+} // namespace freqcomp
+
+#endif
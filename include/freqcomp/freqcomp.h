@@ -0,0 +1,16 @@
+#ifndef FREQCOMP_FREQCOMP_H
+#define FREQCOMP_FREQCOMP_H
+
+// libfreqcomp: projeto de filtros, decimação e reamostragem para o rebaixamento de frequência
+
+#include "freqcomp/span.h"
+#include "freqcomp/filter.h"
+#include "freqcomp/coefficient_bank.h"
+#include "freqcomp/kernels.h"
+#include "freqcomp/decimator.h"
+#include "freqcomp/resampler.h"
+#ifdef FREQCOMP_HAVE_FFTW
+#include "freqcomp/spectrum.h"
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef FREQCOMP_KERNELS_H
+#define FREQCOMP_KERNELS_H
+
+#include <vector>
+
+namespace freqcomp {
+
+// Núcleo do decimador: output[m] = soma de coefficients[k] * taps[k][m], com k em ordem crescente.
+// taps[k] aponta para a componente polifásica (já deslocada) que contém a amostra m * factor - k.
+typedef void (*FirKernelF64)(const double*, const double* const*, int, double*, int);
+typedef void (*FirKernelF32)(const float*, const float* const*, int, float*, int);
+
+// Núcleo multicanal sobre quadros intercalados: output[m * channels + c] é a saída do canal c,
+// calculada a partir de input[(m * factor - k) * channels + c], para c em [channel_begin, channel_end)
+typedef void (*FirInterleavedKernelF64)(const double*, int, const double*, int, int, double*, int, int, int);
+typedef void (*FirInterleavedKernelF32)(const float*, int, const float*, int, int, float*, int, int, int);
+
+// Uma variante do conjunto de núcleos (escalar, SSE2, AVX2 ou AVX-512). Todas somam os
+// coeficientes na mesma ordem, sem FMA, e dão resultados idênticos bit a bit.
+struct FirKernelVariant {
+    const char* name;
+    bool (*supported)();
+    FirKernelF64 f64;
+    FirKernelF32 f32;
+    FirInterleavedKernelF64 interleaved_f64;
+    FirInterleavedKernelF32 interleaved_f32;
+    int lanes_f64; // Amostras por registrador SIMD
+    int lanes_f32;
+};
+
+// Variantes compiladas, da mais larga para a mais estreita (a última é a escalar)
+const std::vector<FirKernelVariant>& fir_kernel_variants();
+
+// Variante escolhida pelo CPUID na inicialização: a mais larga suportada pelo processador
+const FirKernelVariant& selected_fir_kernel();
+
+// Versão escalar de referência (instanciada para float e double)
+template <typename Sample>
+void fir_kernel_scalar(const Sample* coefficients, const Sample* const* taps, int filter_size, Sample* output, int count);
+
+// Chamadas pela variante selecionada
+void fir_decimate_kernel(const double* coefficients, const double* const* taps, int filter_size, double* output, int count);
+void fir_decimate_kernel(const float* coefficients, const float* const* taps, int filter_size, float* output, int count);
+void fir_decimate_interleaved(const double* coefficients, int filter_size, const double* input, int channels, int factor, double* output, int count);
+void fir_decimate_interleaved(const float* coefficients, int filter_size, const float* input, int channels, int factor, float* output, int count);
+
+} // namespace freqcomp
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef FREQCOMP_RESAMPLER_H
+#define FREQCOMP_RESAMPLER_H
+
+#include <vector>
+
+#include "freqcomp/span.h"
+
+namespace freqcomp {
+
+// Reamostrador racional em fluxo contínuo: a razão output_rate / input_rate é reduzida para L/M e
+// o protótipo (projetado na taxa input_rate * L, como em resample_rational) é dividido em L fases.
+// Cada saída usa só a fase correspondente à sua posição. O atraso de grupo é compensado: a saída m
+// fica alinhada com a entrada, e por isso só sai depois de latency() quadros de entrada adiante.
+// Depois do último bloco, flush entrega o restante; a soma das saídas é idêntica bit a bit a
+// resample_rational aplicado a cada canal. Entrada e saída são quadros intercalados.
+template <typename Sample>
+class Resampler {
+public:
+    Resampler(int input_rate, int output_rate, int channels = 1, int zero_crossings = 16);
+
+    // Volta ao estado inicial (nenhuma amostra recebida)
+    void reset();
+
+    // Número máximo de quadros de saída gerados por um bloco de "count" quadros (ou por flush, com 0)
+    int max_output(int count) const;
+
+    // Quadros de entrada que a saída espera adiante de cada amostra (atraso de grupo / L)
+    double latency() const { return (double) delay / L; }
+
+    int interpolation() const { return L; }
+    int decimation() const { return M; }
+    int channel_count() const { return channels; }
+
+    // Reamostra quadros intercalados e retorna quantos quadros de saída foram gravados. output
+    // precisa de espaço para max_output(quadros de entrada) quadros; caso contrário lança std::length_error.
+    size_t process(Span<const Sample> input, Span<Sample> output);
+
+    // Fim do sinal: grava as saídas restantes, até ceil(quadros recebidos * L / M) no total
+    size_t flush(Span<Sample> output);
+
+private:
+    // Gera as saídas cujos quadros de entrada já estão em history (até o quadro available - 1)
+    size_t produce(long long available, long long limit, Sample* output);
+
+    int L;
+    int M;
+    int channels;
+    int phase_length;
+    long long delay;              // Atraso de grupo na taxa interpolada (filter_order / 2)
+    std::vector<Sample> bank;     // bank[p * phase_length + j] = L * protótipo[p + j * L]
+    std::vector<Sample> history;  // Quadros a partir de history_start (intercalados)
+    long long history_start;      // Índice do primeiro quadro de history (negativo = zeros iniciais)
+    long long received;           // Quadros recebidos desde reset
+    long long next_output;        // Índice da próxima saída
+};
+
+extern template class Resampler<double>;
+extern template class Resampler<float>;
+
+} // namespace freqcomp
+
+#endif
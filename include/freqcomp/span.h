@@ -0,0 +1,34 @@
+#ifndef FREQCOMP_SPAN_H
+#define FREQCOMP_SPAN_H
+
+#include <cstddef>
+
+namespace freqcomp {
+
+// Visão (ponteiro + tamanho) sobre amostras contíguas, sem posse da memória.
+// Equivalente mínimo de std::span (C++20) para manter a biblioteca em C++11.
+template <typename T>
+class Span {
+public:
+    Span() : ptr(nullptr), length(0) {}
+    Span(T* data, size_t size) : ptr(data), length(size) {}
+
+    // Qualquer contêiner contíguo com data() e size(), por exemplo std::vector
+    template <typename Container>
+    Span(Container& container) : ptr(container.data()), length(container.size()) {}
+
+    T* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    T& operator[](size_t i) const { return ptr[i]; }
+
+    Span subspan(size_t offset, size_t count) const { return Span(ptr + offset, count); }
+
+private:
+    T* ptr;
+    size_t length;
+};
+
+} // namespace freqcomp
+
+#endif
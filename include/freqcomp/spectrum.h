@@ -0,0 +1,94 @@
+#ifndef FREQCOMP_SPECTRUM_H
+#define FREQCOMP_SPECTRUM_H
+
+// Análise e reamostragem espectral com FFTW (só disponível quando a biblioteca é compilada com
+// FFTW, o que define FREQCOMP_HAVE_FFTW para quem a usa)
+
+#include <complex>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <fftw3.h>
+
+namespace freqcomp {
+
+// Cache de planos FFTW compartilhado por todo o processo.
+// Cada plano é criado uma única vez por (tamanho, direção, alinhamento) e depois reaproveitado
+// com fftw_execute_dft sobre novos arrays. O planejamento usa FFTW_MEASURE (ou FFTW_PATIENT) e o
+// wisdom acumulado pode ser salvo em arquivo e recarregado na próxima execução.
+class FFTPlanCache {
+public:
+    static FFTPlanCache& instance();
+
+    // Rigor do planejador (FFTW_ESTIMATE, FFTW_MEASURE ou FFTW_PATIENT)
+    void set_planner_flags(unsigned flags);
+
+    bool import_wisdom(const std::string& path);
+    bool export_wisdom(const std::string& path);
+
+    // Plano de DFT complexa de tamanho N compatível com os arrays in/out (executar com fftw_execute_dft)
+    fftw_plan dft(int N, int sign, fftw_complex* in, fftw_complex* out);
+
+    // Plano real -> complexo: N amostras reais geram N/2 + 1 bins (executar com fftw_execute_dft_r2c)
+    fftw_plan r2c(int N, double* in, fftw_complex* out);
+
+    // Plano complexo -> real a partir de N/2 + 1 bins (executar com fftw_execute_dft_c2r; a entrada é destruída)
+    fftw_plan c2r(int N, fftw_complex* in, double* out);
+
+    FFTPlanCache(const FFTPlanCache&) = delete;
+    FFTPlanCache& operator=(const FFTPlanCache&) = delete;
+
+private:
+    struct PlanKey {
+        int size;
+        int kind;
+        int alignment;
+        bool in_place;
+
+        bool operator<(const PlanKey& other) const;
+    };
+
+    template <typename Make>
+    fftw_plan find_or_plan(const PlanKey& key, Make make);
+
+    FFTPlanCache();
+    ~FFTPlanCache();
+
+    std::mutex mutex;
+    std::map<PlanKey, fftw_plan> plans;
+    unsigned planner_flags;
+    int max_measured_size; // Acima disso, sem wisdom, usa FFTW_ESTIMATE para não gastar minutos planejando
+};
+
+// Arquivo de wisdom: variável de ambiente FFTW_WISDOM ou media/fftw_wisdom.dat
+std::string fft_wisdom_file();
+
+// Carrega o wisdom salvo e aplica o rigor pedido em FFTW_RIGOR (estimate, measure ou patient)
+void load_fft_wisdom();
+
+// Salva o wisdom acumulado para as próximas execuções
+void save_fft_wisdom();
+
+// FFT real -> complexo: os N/2 + 1 bins não negativos (o espectro de um sinal real é hermitiano).
+// Sinais com menos de 512 amostras retornam um espectro vazio.
+std::vector<std::complex<double>> computeFFT(const std::vector<double>& signal);
+
+// As N magnitudes do espectro completo, espelhando a metade guardada por computeFFT (vazio se o espectro for vazio)
+std::vector<double> magnitude_spectrum(const std::vector<std::complex<double>>& spectrum, int N);
+
+// Grava as N magnitudes em um arquivo de texto, uma por linha
+void saveFFTtoFile(const std::vector<std::complex<double>>& spectrum, int N, const std::string& filename);
+
+// Zera os bins acima de target_rate (mesmo tamanho de espectro)
+std::vector<std::complex<double>> reduceFrequency(const std::vector<std::complex<double>>& spectrum, int original_rate, int target_rate);
+
+// Recorta (ou completa com zeros) o espectro de N amostras para uma IFFT de output_size amostras
+std::vector<std::complex<double>> cropSpectrum(const std::vector<std::complex<double>>& spectrum, int N, int output_size);
+
+// IFFT complexo -> real a partir de N/2 + 1 bins, normalizada por N
+std::vector<double> computeIFFT(const std::vector<std::complex<double>>& spectrum, int N);
+
+} // namespace freqcomp
+
+#endif
@@ -0,0 +1,226 @@
+// Banco de coeficientes FIR: memorização por projeto, arquivo binário e tabelas padrão constexpr
+
+#include "freqcomp/coefficient_bank.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#define PI 3.14159265358979323846
+
+namespace freqcomp {
+
+// sin e cos avaliáveis em tempo de compilação (C++11: uma única expressão por função), precisos o
+// bastante para arredondar para o mesmo double que a libm. O argumento (double) é reduzido a
+// [-pi/4, pi/4] em long double com pi/2 dividido em três partes (32 + 32 + 64 bits): as duas
+// primeiras subtrações são exatas, então o resto fica correto mesmo perto dos zeros de sin e cos.
+// A série de Taylor é somada em long double até o termo de grau 41.
+typedef long double cx_real;
+
+constexpr cx_real half_pi_1 = 3373259426.0L / 2147483648.0L;
+constexpr cx_real half_pi_2 = 560513588.0L / 9223372036854775808.0L;
+constexpr cx_real half_pi_3 = 14179128828124470481.0L / 9223372036854775808.0L / 9223372036854775808.0L / 2.0L;
+
+constexpr cx_real cx_series(cx_real r2, cx_real term, int n, cx_real sum) {
+    return n > 41 ? sum : cx_series(r2, -term * r2 / ((n + 1) * (n + 2)), n + 2, sum + term);
+}
+
+// Múltiplo de pi/2 mais próximo de x
+constexpr long long cx_quadrant(double x) {
+    return (long long) (x / (PI / 2) + (x < 0 ? -0.5 : 0.5));
+}
+
+constexpr cx_real cx_reduce(double x, long long k) {
+    return (((cx_real) x - k * half_pi_1) - k * half_pi_2) - k * half_pi_3;
+}
+
+// sin(r + q * pi/2) para r em [-pi/4, pi/4]
+constexpr cx_real cx_sin_quadrant(cx_real r, int q) {
+    return q == 0 ? cx_series(r * r, r, 1, 0.0L)
+         : q == 1 ? cx_series(r * r, 1.0L, 0, 0.0L)
+         : q == 2 ? -cx_series(r * r, r, 1, 0.0L)
+                  : -cx_series(r * r, 1.0L, 0, 0.0L);
+}
+
+constexpr double cx_sin(double x) {
+    return (double) cx_sin_quadrant(cx_reduce(x, cx_quadrant(x)), (int) ((cx_quadrant(x) % 4 + 4) % 4));
+}
+
+constexpr double cx_cos(double x) {
+    return (double) cx_sin_quadrant(cx_reduce(x, cx_quadrant(x)), (int) ((cx_quadrant(x) % 4 + 5) % 4));
+}
+
+// Coeficiente i do projeto com janela de Hamming, na mesma ordem de operações de generate_fir_coefficients
+constexpr double cx_fir_tap(int filter_order, double norm_cutoff, int i) {
+    return i == filter_order / 2
+        ? norm_cutoff
+        : cx_sin(PI * norm_cutoff * (i - filter_order / 2)) / (PI * (i - filter_order / 2)) *
+              (0.54 - 0.46 * cx_cos(2 * PI * i / filter_order));
+}
+
+// Sequência de índices 0..N-1 para expandir as tabelas (std::index_sequence só existe a partir do C++14)
+template <int... Is>
+struct TapIndices {};
+
+template <int N, int... Is>
+struct MakeTapIndices : MakeTapIndices<N - 1, N - 1, Is...> {};
+
+template <int... Is>
+struct MakeTapIndices<0, Is...> {
+    typedef TapIndices<Is...> type;
+};
+
+template <int Order, int Cutoff, int Rate, int... Is>
+constexpr std::array<double, Order + 1> make_fir_table(TapIndices<Is...>) {
+    return {{cx_fir_tap(Order, (double) Cutoff / ((double) Rate / 2), Is)...}};
+}
+
+// Coeficientes de uma configuração padrão, calculados pelo compilador
+template <int Order, int Cutoff, int Rate>
+struct StandardFir {
+    static constexpr std::array<double, Order + 1> coefficients =
+        make_fir_table<Order, Cutoff, Rate>(typename MakeTapIndices<Order + 1>::type());
+};
+
+template <int Order, int Cutoff, int Rate>
+constexpr std::array<double, Order + 1> StandardFir<Order, Cutoff, Rate>::coefficients;
+
+static const StandardFirTable standard_tables[] = {
+    {31, 500.0, 8000.0, StandardFir<31, 500, 8000>::coefficients.data()},
+    {31, 4000.0, 44100.0, StandardFir<31, 4000, 44100>::coefficients.data()},
+    {31, 10800.0, 48000.0, StandardFir<31, 10800, 48000>::coefficients.data()},
+    {63, 7200.0, 48000.0, StandardFir<63, 7200, 48000>::coefficients.data()},
+    {96, 7200.0, 48000.0, StandardFir<96, 7200, 48000>::coefficients.data()},
+};
+
+Span<const StandardFirTable> standard_fir_tables() {
+    return Span<const StandardFirTable>(standard_tables, sizeof(standard_tables) / sizeof(standard_tables[0]));
+}
+
+const StandardFirTable* find_standard_fir_table(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window) {
+    if (window != HAMMING) {
+        return nullptr;
+    }
+    for (const StandardFirTable& table : standard_tables) {
+        if (table.order == filter_order && table.cutoff == cutoff_frequency && table.rate == sampling_rate) {
+            return &table;
+        }
+    }
+    return nullptr;
+}
+
+bool CoefficientBank::Key::operator<(const Key& other) const {
+    if (order != other.order) return order < other.order;
+    if (cutoff != other.cutoff) return cutoff < other.cutoff;
+    if (rate != other.rate) return rate < other.rate;
+    return window < other.window;
+}
+
+CoefficientBank::CoefficientBank() : hit_count(0), miss_count(0) {}
+
+CoefficientBank& CoefficientBank::instance() {
+    static CoefficientBank bank;
+    return bank;
+}
+
+const std::vector<double>& CoefficientBank::get(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window) {
+    Key key = {filter_order, cutoff_frequency, sampling_rate, window};
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<Key, std::vector<double>>::iterator it = entries.find(key);
+    if (it != entries.end()) {
+        hit_count++;
+        return it->second;
+    }
+    miss_count++;
+    std::vector<double>& coefficients = entries[key];
+    const StandardFirTable* table = find_standard_fir_table(filter_order, cutoff_frequency, sampling_rate, window);
+    if (table) {
+        coefficients.assign(table->coefficients, table->coefficients + filter_order + 1);
+    } else {
+        coefficients = generate_fir_coefficients(filter_order, cutoff_frequency, sampling_rate, window);
+    }
+    return coefficients;
+}
+
+bool CoefficientBank::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Erro ao criar o banco de coeficientes " << path << std::endl;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t header[3] = {magic, version, (uint32_t) entries.size()};
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for (std::map<Key, std::vector<double>>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+        int32_t order = it->first.order;
+        int32_t window = it->first.window;
+        file.write(reinterpret_cast<const char*>(&order), sizeof(order));
+        file.write(reinterpret_cast<const char*>(&it->first.cutoff), sizeof(double));
+        file.write(reinterpret_cast<const char*>(&it->first.rate), sizeof(double));
+        file.write(reinterpret_cast<const char*>(&window), sizeof(window));
+        file.write(reinterpret_cast<const char*>(it->second.data()), it->second.size() * sizeof(double));
+    }
+    return (bool) file;
+}
+
+bool CoefficientBank::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    uint32_t header[3];
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != magic || header[1] != version) {
+        std::cerr << "Erro ao ler o banco de coeficientes " << path << ": formato inválido" << std::endl;
+        return false;
+    }
+    std::map<Key, std::vector<double>> loaded;
+    for (uint32_t e = 0; e < header[2]; e++) {
+        int32_t order;
+        int32_t window;
+        Key key;
+        file.read(reinterpret_cast<char*>(&order), sizeof(order));
+        file.read(reinterpret_cast<char*>(&key.cutoff), sizeof(double));
+        file.read(reinterpret_cast<char*>(&key.rate), sizeof(double));
+        file.read(reinterpret_cast<char*>(&window), sizeof(window));
+        if (!file || order < 0 || order > (1 << 24) || window < HAMMING || window > BLACKMAN) {
+            std::cerr << "Erro ao ler o banco de coeficientes " << path << ": entrada " << e << " inválida" << std::endl;
+            return false;
+        }
+        key.order = order;
+        key.window = (FirWindow) window;
+        std::vector<double> coefficients(order + 1);
+        if (!file.read(reinterpret_cast<char*>(coefficients.data()), coefficients.size() * sizeof(double))) {
+            std::cerr << "Erro ao ler o banco de coeficientes " << path << ": arquivo truncado" << std::endl;
+            return false;
+        }
+        loaded[key].swap(coefficients);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::map<Key, std::vector<double>>::iterator it = loaded.begin(); it != loaded.end(); ++it) {
+        entries.insert(std::make_pair(it->first, std::move(it->second)));
+    }
+    return true;
+}
+
+size_t CoefficientBank::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+size_t CoefficientBank::hits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hit_count;
+}
+
+size_t CoefficientBank::misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return miss_count;
+}
+
+const std::vector<double>& cached_fir_coefficients(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window) {
+    return CoefficientBank::instance().get(filter_order, cutoff_frequency, sampling_rate, window);
+}
+
+} // namespace freqcomp
@@ -0,0 +1,100 @@
+#include "freqcomp/decimator.h"
+#include "freqcomp/kernels.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace freqcomp {
+
+// Amostras por registrador da variante de núcleo selecionada
+static int kernel_lanes(double) { return selected_fir_kernel().lanes_f64; }
+static int kernel_lanes(float) { return selected_fir_kernel().lanes_f32; }
+
+template <typename Sample>
+Decimator<Sample>::Decimator(const std::vector<double>& coefficients, int factor, int channels)
+    : coefficients(coefficients.begin(), coefficients.end()), factor(factor), channels(channels), phases(factor), taps(coefficients.size()) {
+    if (coefficients.empty() || factor < 1 || channels < 1) {
+        throw std::invalid_argument("Decimator: filtro vazio, fator ou número de canais inválido");
+    }
+    // Canais nas posições do registrador só quando eles preenchem registradores inteiros; com menos
+    // canais (estéreo, por exemplo) cada canal é filtrado separadamente, com saídas consecutivas
+    // nas posições, como no caso de um canal
+    interleaved = channels > 1 && channels % kernel_lanes(Sample()) == 0;
+    reset();
+}
+
+template <typename Sample>
+void Decimator<Sample>::reset() {
+    history.assign((coefficients.size() - 1) * channels, Sample(0));
+    next_output = coefficients.size() - 1;
+}
+
+template <typename Sample>
+void Decimator<Sample>::prime(const Sample* frames, int count) {
+    if (count < 0 || count > (int) coefficients.size() - 1) {
+        throw std::invalid_argument("Decimator::prime: mais quadros que a linha de atraso (filter_size - 1)");
+    }
+    reset();
+    std::copy(frames, frames + (size_t) count * channels, history.end() - (size_t) count * channels);
+}
+
+template <typename Sample>
+int Decimator<Sample>::process(const Sample* input, int count, Sample* output) {
+    int filter_size = coefficients.size();
+    history.insert(history.end(), input, input + (size_t) count * channels);
+    int size = history.size() / channels;
+
+    int produced = next_output < size ? (size - 1 - next_output) / factor + 1 : 0;
+    if (produced > 0 && interleaved) {
+        fir_decimate_interleaved(coefficients.data(), filter_size, history.data() + (size_t) next_output * channels,
+                                 channels, factor, output, produced);
+    } else if (produced > 0) {
+        int base = next_output - (filter_size - 1);
+        for (int c = 0; c < channels; c++) {
+            // Componentes polifásicas do canal c no trecho da linha de atraso usado por este bloco
+            for (int p = 0; p < factor; p++) {
+                int length = base + p < size ? (size - 1 - base - p) / factor + 1 : 0;
+                phases[p].resize(length);
+                Sample* y = phases[p].data();
+                for (int j = 0; j < length; j++) {
+                    y[j] = history[(size_t) (base + p + j * factor) * channels + c];
+                }
+            }
+            for (int k = 0; k < filter_size; k++) {
+                int a = filter_size - 1 - k;
+                taps[k] = phases[a % factor].data() + a / factor;
+            }
+            if (channels == 1) {
+                fir_decimate_kernel(coefficients.data(), taps.data(), filter_size, output, produced);
+            } else {
+                channel_output.resize(produced);
+                fir_decimate_kernel(coefficients.data(), taps.data(), filter_size, channel_output.data(), produced);
+                for (int m = 0; m < produced; m++) {
+                    output[(size_t) m * channels + c] = channel_output[m];
+                }
+            }
+        }
+    }
+
+    // Descarta os quadros que nenhuma saída futura vai usar
+    next_output += produced * factor;
+    int discard = std::min(size, next_output - (filter_size - 1));
+    history.erase(history.begin(), history.begin() + (size_t) discard * channels);
+    next_output -= discard;
+
+    return produced;
+}
+
+template <typename Sample>
+size_t Decimator<Sample>::process(Span<const Sample> input, Span<Sample> output) {
+    int count = input.size() / channels;
+    if (output.size() < (size_t) max_output(count) * channels) {
+        throw std::length_error("Decimator::process: saída menor que max_output(quadros de entrada)");
+    }
+    return process(input.data(), count, output.data());
+}
+
+template class Decimator<double>;
+template class Decimator<float>;
+
+} // namespace freqcomp
@@ -0,0 +1,213 @@
+// Projeto de filtros FIR, filtragem, decimação e reamostragem racional de sinais inteiros
+
+#include "freqcomp/filter.h"
+#include "freqcomp/kernels.h"
+#include "freqcomp/coefficient_bank.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define PI 3.14159265358979323846
+
+// polyphase_decimate precisa ser idêntico bit a bit a apply_fir_filter + downsample: multiplicação
+// e soma não podem ser fundidas em FMA em só um dos caminhos
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+namespace freqcomp {
+
+// Valor da janela na posição i de um filtro de ordem filter_order
+static double window_value(FirWindow window, int i, int filter_order) {
+    switch (window) {
+    case HANN:
+        return 0.5 - 0.5 * cos(2 * PI * i / filter_order);
+    case BLACKMAN:
+        return 0.42 - 0.5 * cos(2 * PI * i / filter_order) + 0.08 * cos(4 * PI * i / filter_order);
+    default:
+        return 0.54 - 0.46 * cos(2 * PI * i / filter_order); // Janela de Hamming
+    }
+}
+
+// Função para gerar coeficientes FIR com uma janela (Hamming por padrão)
+std::vector<double> generate_fir_coefficients(int filter_order, double cutoff_frequency, double sampling_rate, FirWindow window) {
+    std::vector<double> coefficients(filter_order + 1);
+    double norm_cutoff = cutoff_frequency / (sampling_rate / 2); // Normalizando a frequência de corte
+
+    for (int i = 0; i <= filter_order; i++) {
+        int middle = filter_order / 2;
+        if (i == middle) {
+            coefficients[i] = norm_cutoff;
+        } else {
+            double sinc_value = sin(PI * norm_cutoff * (i - middle)) / (PI * (i - middle));
+            coefficients[i] = sinc_value * window_value(window, i, filter_order);
+        }
+    }
+    return coefficients;
+}
+
+// Aplica o filtro FIR ao sinal
+std::vector<double> apply_fir_filter(const std::vector<double>& input_signal, const std::vector<double>& coefficients) {
+    int filter_size = coefficients.size();
+    int signal_size = input_signal.size();
+    std::vector<double> output_signal(signal_size, 0.0);
+
+    // Prólogo: nas primeiras amostras só existem n + 1 entradas anteriores
+    int warmup = std::min(filter_size - 1, signal_size);
+    for (int n = 0; n < warmup; n++) {
+        for (int k = 0; k <= n; k++) {
+            output_signal[n] += coefficients[k] * input_signal[n - k];
+        }
+    }
+
+    // Regime permanente, sem teste por coeficiente no laço interno
+    for (int n = warmup; n < signal_size; n++) {
+        for (int k = 0; k < filter_size; k++) {
+            output_signal[n] += coefficients[k] * input_signal[n - k];
+        }
+    }
+    return output_signal;
+}
+
+// Função para reduzir a taxa de amostragem (decimação)
+std::vector<double> downsample(const std::vector<double>& signal, int factor) {
+    std::vector<double> downsampled_signal;
+    for (size_t i = 0; i < signal.size(); i += factor) {
+        downsampled_signal.push_back(signal[i]);
+    }
+    return downsampled_signal;
+}
+
+// Máximo divisor comum, usado para reduzir a razão entre as taxas
+int gcd(int a, int b) {
+    while (b != 0) {
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Decimador FIR polifásico: calcula diretamente apenas as amostras que sobrevivem à decimação.
+// O sinal é separado em "factor" componentes polifásicas e cada coeficiente k é associado à
+// componente (e ao deslocamento) onde está a amostra n - k. Os coeficientes são acumulados na
+// mesma ordem de apply_fir_filter, então o resultado é idêntico bit a bit a filtrar e depois decimar.
+std::vector<double> polyphase_decimate(const std::vector<double>& input_signal, const std::vector<double>& coefficients, int factor) {
+    int filter_size = coefficients.size();
+    int signal_size = input_signal.size();
+    int output_size = (signal_size + factor - 1) / factor;
+    std::vector<double> output_signal(output_size, 0.0);
+
+    // Componentes polifásicas: phases[p][j] = input_signal[j * factor + p]
+    std::vector<std::vector<double>> phases(factor);
+    for (int p = 0; p < factor; p++) {
+        phases[p].reserve(output_size);
+        for (int i = p; i < signal_size; i += factor) {
+            phases[p].push_back(input_signal[i]);
+        }
+    }
+
+    // Para a saída m, o coeficiente k = q * factor + r lê input_signal[m * factor - k], que está
+    // em phases[0][m - q] quando r == 0 e em phases[factor - r][m - q - 1] caso contrário.
+    std::vector<const double*> tap_phase(filter_size);
+    std::vector<int> tap_offset(filter_size);
+    for (int k = 0; k < filter_size; k++) {
+        int q = k / factor;
+        int r = k % factor;
+        tap_phase[k] = (r == 0) ? phases[0].data() : phases[factor - r].data();
+        tap_offset[k] = (r == 0) ? q : q + 1;
+    }
+
+    // Prólogo: saídas cujo histórico ainda não cobre todos os coeficientes
+    int first_full = std::min(output_size, (filter_size - 1 + factor - 1) / factor);
+    for (int m = 0; m < first_full; m++) {
+        for (int k = 0; k < filter_size && k <= m * factor; k++) {
+            output_signal[m] += coefficients[k] * tap_phase[k][m - tap_offset[k]];
+        }
+    }
+
+    // Regime permanente (nenhuma saída quando o sinal é vazio ou mais curto que o filtro)
+    if (output_size <= first_full) {
+        return output_signal;
+    }
+    std::vector<const double*> taps(filter_size);
+    for (int k = 0; k < filter_size; k++) {
+        taps[k] = tap_phase[k] + (first_full - tap_offset[k]);
+    }
+    fir_decimate_kernel(coefficients.data(), taps.data(), filter_size, output_signal.data() + first_full, output_size - first_full);
+
+    return output_signal;
+}
+
+// Reamostragem racional L/M com banco de filtros polifásico.
+// A razão output_rate / input_rate é reduzida para L/M; o filtro protótipo é projetado na taxa
+// input_rate * L (e memorizado no banco de coeficientes compartilhado) e dividido em L fases. Cada
+// amostra de saída usa apenas a fase correspondente à sua posição, sem calcular as intermediárias.
+std::vector<double> resample_rational(const std::vector<double>& signal, int input_rate, int output_rate, int zero_crossings) {
+    int g = gcd(input_rate, output_rate);
+    int L = output_rate / g; // Fator de interpolação
+    int M = input_rate / g;  // Fator de decimação
+    int N = signal.size();
+
+    // Corte abaixo da menor frequência de Nyquist, com margem para a banda de transição
+    double cutoff = 0.45 * std::min(input_rate, output_rate);
+    int filter_order = 2 * zero_crossings * std::max(L, M);
+    const std::vector<double>& prototype = cached_fir_coefficients(filter_order, cutoff, (double) input_rate * L);
+
+    // Banco polifásico: bank[p * phase_length + j] = L * prototype[p + j * L]
+    int phase_length = (filter_order + L) / L;
+    std::vector<double> bank(L * phase_length, 0.0);
+    for (int i = 0; i <= filter_order; i++) {
+        bank[(i % L) * phase_length + i / L] = L * prototype[i];
+    }
+
+    // O atraso de grupo do filtro (filter_order / 2 na taxa interpolada) é compensado
+    long long delay = filter_order / 2;
+    int output_size = (int) (((long long) N * L + M - 1) / M);
+    std::vector<double> output(output_size);
+
+    for (int m = 0; m < output_size; m++) {
+        long long t = (long long) m * M + delay;
+        int n = (int) (t / L);
+        const double* h = bank.data() + (t % L) * phase_length;
+
+        int j_begin = std::max(0, n - (N - 1));
+        int j_end = std::min(phase_length - 1, n);
+        double acc = 0.0;
+        for (int j = j_begin; j <= j_end; j++) {
+            acc += h[j] * signal[n - j];
+        }
+        output[m] = acc;
+    }
+
+    return output;
+}
+
+// Separa quadros intercalados em um vetor por canal
+std::vector<std::vector<double>> deinterleave(const std::vector<double>& frames, int channels) {
+    size_t num_frames = frames.size() / channels;
+    std::vector<std::vector<double>> planar(channels, std::vector<double>(num_frames));
+    for (size_t i = 0; i < num_frames; i++) {
+        for (int c = 0; c < channels; c++) {
+            planar[c][i] = frames[i * channels + c];
+        }
+    }
+    return planar;
+}
+
+// Junta os canais de volta em quadros intercalados (todos com o mesmo número de amostras)
+std::vector<double> interleave(const std::vector<std::vector<double>>& planar) {
+    int channels = planar.size();
+    size_t num_frames = planar[0].size();
+    std::vector<double> frames(num_frames * channels);
+    for (size_t i = 0; i < num_frames; i++) {
+        for (int c = 0; c < channels; c++) {
+            frames[i * channels + c] = planar[c][i];
+        }
+    }
+    return frames;
+}
+
+} // namespace freqcomp
@@ -0,0 +1,204 @@
+// Núcleos FIR do decimador: versão escalar e variantes SIMD (SSE2, AVX2, AVX-512), com a
+// variante escolhida pelo CPUID na primeira chamada
+
+#include "freqcomp/kernels.h"
+
+#include <algorithm>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // Intrínsecos SSE2/AVX2/AVX-512
+#endif
+
+// A comparação bit a bit entre os caminhos exige que multiplicação e soma não sejam fundidas em FMA
+// (o que o compilador faria só em algumas variantes, por exemplo ao habilitar AVX-512)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+namespace freqcomp {
+
+// Núcleo do decimador para um intervalo de saídas: output[m] = soma de coefficients[k] * taps[k][m],
+// com k em ordem crescente. taps[k] aponta para a componente polifásica (já deslocada) que contém
+// a amostra m * factor - k.
+template <typename Sample>
+void fir_kernel_range(const Sample* coefficients, const Sample* const* taps, int filter_size, Sample* output, int begin, int end) {
+    for (int m = begin; m < end; m++) {
+        output[m] = 0;
+    }
+    for (int k = 0; k < filter_size; k++) {
+        Sample c = coefficients[k];
+        const Sample* x = taps[k];
+        for (int m = begin; m < end; m++) {
+            output[m] += c * x[m];
+        }
+    }
+}
+
+// Versão escalar, em blocos de saídas para manter os acumuladores e as componentes no cache
+template <typename Sample>
+void fir_kernel_scalar(const Sample* coefficients, const Sample* const* taps, int filter_size, Sample* output, int count) {
+    const int block_size = 256;
+    for (int start = 0; start < count; start += block_size) {
+        fir_kernel_range(coefficients, taps, filter_size, output, start, std::min(count, start + block_size));
+    }
+}
+
+// Núcleo multicanal sobre quadros intercalados: output[m * channels + c] é a saída do canal c,
+// calculada a partir de input[(m * factor - k) * channels + c]. input aponta para o quadro da
+// primeira saída e precisa ter filter_size - 1 quadros de histórico antes dele.
+template <typename Sample>
+void fir_kernel_interleaved_scalar(const Sample* coefficients, int filter_size, const Sample* input, int channels, int factor,
+                                   Sample* output, int count, int channel_begin, int channel_end) {
+    for (int c = channel_begin; c < channel_end; c++) {
+        for (int m = 0; m < count; m++) {
+            const Sample* x = input + (long) m * factor * channels + c;
+            Sample acc = 0;
+            for (int k = 0; k < filter_size; k++) {
+                acc += coefficients[k] * x[-k * channels];
+            }
+            output[m * channels + c] = acc;
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Versões SIMD: cada registrador guarda saídas consecutivas e cada coeficiente é replicado em todas
+// as posições. Cada saída continua acumulando os coeficientes em ordem crescente (multiplicação e
+// soma separadas, sem FMA), então o resultado é idêntico bit a bit ao da versão escalar.
+#define FIR_KERNEL_SIMD(name, isa, Sample, Vec, lanes, set1, setzero, loadu, storeu, mul, add)          \
+    __attribute__((target(isa)))                                                                        \
+    void name(const Sample* coefficients, const Sample* const* taps, int filter_size, Sample* output, int count) { \
+        int m = 0;                                                                                      \
+        for (; m + 4 * lanes <= count; m += 4 * lanes) {                                                \
+            Vec acc0 = setzero(), acc1 = setzero(), acc2 = setzero(), acc3 = setzero();                 \
+            for (int k = 0; k < filter_size; k++) {                                                     \
+                Vec c = set1(coefficients[k]);                                                          \
+                const Sample* x = taps[k] + m;                                                          \
+                acc0 = add(acc0, mul(c, loadu(x)));                                                     \
+                acc1 = add(acc1, mul(c, loadu(x + lanes)));                                             \
+                acc2 = add(acc2, mul(c, loadu(x + 2 * lanes)));                                         \
+                acc3 = add(acc3, mul(c, loadu(x + 3 * lanes)));                                         \
+            }                                                                                           \
+            storeu(output + m, acc0);                                                                   \
+            storeu(output + m + lanes, acc1);                                                           \
+            storeu(output + m + 2 * lanes, acc2);                                                       \
+            storeu(output + m + 3 * lanes, acc3);                                                       \
+        }                                                                                               \
+        for (; m + lanes <= count; m += lanes) {                                                        \
+            Vec acc = setzero();                                                                        \
+            for (int k = 0; k < filter_size; k++) {                                                     \
+                acc = add(acc, mul(set1(coefficients[k]), loadu(taps[k] + m)));                         \
+            }                                                                                           \
+            storeu(output + m, acc);                                                                    \
+        }                                                                                               \
+        fir_kernel_range(coefficients, taps, filter_size, output, m, count);                            \
+    }
+
+// Versões multicanal: os canais de um quadro ocupam as posições do registrador, lidos direto dos
+// quadros intercalados. Os canais que sobram de um registrador ficam com a variante mais estreita.
+#define FIR_KERNEL_INTERLEAVED_SIMD(name, isa, narrower, Sample, Vec, lanes, set1, setzero, loadu, storeu, mul, add) \
+    __attribute__((target(isa)))                                                                        \
+    void name(const Sample* coefficients, int filter_size, const Sample* input, int channels, int factor, \
+              Sample* output, int count, int channel_begin, int channel_end) {                          \
+        long stride = (long) factor * channels;                                                         \
+        int c = channel_begin;                                                                          \
+        for (; c + lanes <= channel_end; c += lanes) {                                                  \
+            int m = 0;                                                                                  \
+            for (; m + 4 <= count; m += 4) {                                                            \
+                const Sample* x = input + m * stride + c;                                               \
+                Vec acc0 = setzero(), acc1 = setzero(), acc2 = setzero(), acc3 = setzero();             \
+                for (int k = 0; k < filter_size; k++) {                                                 \
+                    Vec h = set1(coefficients[k]);                                                      \
+                    const Sample* xk = x - (long) k * channels;                                         \
+                    acc0 = add(acc0, mul(h, loadu(xk)));                                                \
+                    acc1 = add(acc1, mul(h, loadu(xk + stride)));                                       \
+                    acc2 = add(acc2, mul(h, loadu(xk + 2 * stride)));                                   \
+                    acc3 = add(acc3, mul(h, loadu(xk + 3 * stride)));                                   \
+                }                                                                                       \
+                storeu(output + m * channels + c, acc0);                                                \
+                storeu(output + (m + 1) * channels + c, acc1);                                          \
+                storeu(output + (m + 2) * channels + c, acc2);                                          \
+                storeu(output + (m + 3) * channels + c, acc3);                                          \
+            }                                                                                           \
+            for (; m < count; m++) {                                                                    \
+                const Sample* x = input + m * stride + c;                                               \
+                Vec acc = setzero();                                                                    \
+                for (int k = 0; k < filter_size; k++) {                                                 \
+                    acc = add(acc, mul(set1(coefficients[k]), loadu(x - (long) k * channels)));         \
+                }                                                                                       \
+                storeu(output + m * channels + c, acc);                                                 \
+            }                                                                                           \
+        }                                                                                               \
+        narrower(coefficients, filter_size, input, channels, factor, output, count, c, channel_end);    \
+    }
+
+FIR_KERNEL_SIMD(fir_kernel_sse2, "sse2", double, __m128d, 2, _mm_set1_pd, _mm_setzero_pd, _mm_loadu_pd, _mm_storeu_pd, _mm_mul_pd, _mm_add_pd)
+FIR_KERNEL_SIMD(fir_kernel_avx2, "avx2", double, __m256d, 4, _mm256_set1_pd, _mm256_setzero_pd, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_mul_pd, _mm256_add_pd)
+FIR_KERNEL_SIMD(fir_kernel_avx512, "avx512f", double, __m512d, 8, _mm512_set1_pd, _mm512_setzero_pd, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_mul_pd, _mm512_add_pd)
+FIR_KERNEL_SIMD(fir_kernel_sse2_f32, "sse2", float, __m128, 4, _mm_set1_ps, _mm_setzero_ps, _mm_loadu_ps, _mm_storeu_ps, _mm_mul_ps, _mm_add_ps)
+FIR_KERNEL_SIMD(fir_kernel_avx2_f32, "avx2", float, __m256, 8, _mm256_set1_ps, _mm256_setzero_ps, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_mul_ps, _mm256_add_ps)
+FIR_KERNEL_SIMD(fir_kernel_avx512_f32, "avx512f", float, __m512, 16, _mm512_set1_ps, _mm512_setzero_ps, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_mul_ps, _mm512_add_ps)
+FIR_KERNEL_INTERLEAVED_SIMD(fir_kernel_interleaved_sse2, "sse2", fir_kernel_interleaved_scalar<double>, double, __m128d, 2, _mm_set1_pd, _mm_setzero_pd, _mm_loadu_pd, _mm_storeu_pd, _mm_mul_pd, _mm_add_pd)
+FIR_KERNEL_INTERLEAVED_SIMD(fir_kernel_interleaved_avx2, "avx2", fir_kernel_interleaved_sse2, double, __m256d, 4, _mm256_set1_pd, _mm256_setzero_pd, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_mul_pd, _mm256_add_pd)
+FIR_KERNEL_INTERLEAVED_SIMD(fir_kernel_interleaved_avx512, "avx512f", fir_kernel_interleaved_avx2, double, __m512d, 8, _mm512_set1_pd, _mm512_setzero_pd, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_mul_pd, _mm512_add_pd)
+FIR_KERNEL_INTERLEAVED_SIMD(fir_kernel_interleaved_sse2_f32, "sse2", fir_kernel_interleaved_scalar<float>, float, __m128, 4, _mm_set1_ps, _mm_setzero_ps, _mm_loadu_ps, _mm_storeu_ps, _mm_mul_ps, _mm_add_ps)
+FIR_KERNEL_INTERLEAVED_SIMD(fir_kernel_interleaved_avx2_f32, "avx2", fir_kernel_interleaved_sse2_f32, float, __m256, 8, _mm256_set1_ps, _mm256_setzero_ps, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_mul_ps, _mm256_add_ps)
+FIR_KERNEL_INTERLEAVED_SIMD(fir_kernel_interleaved_avx512_f32, "avx512f", fir_kernel_interleaved_avx2_f32, float, __m512, 16, _mm512_set1_ps, _mm512_setzero_ps, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_mul_ps, _mm512_add_ps)
+#endif
+
+template void fir_kernel_scalar<double>(const double*, const double* const*, int, double*, int);
+template void fir_kernel_scalar<float>(const float*, const float* const*, int, float*, int);
+
+const std::vector<FirKernelVariant>& fir_kernel_variants() {
+    static const std::vector<FirKernelVariant> variants = {
+#if defined(__x86_64__) || defined(__i386__)
+        {"avx512", [] { return __builtin_cpu_supports("avx512f") != 0; }, fir_kernel_avx512, fir_kernel_avx512_f32,
+         fir_kernel_interleaved_avx512, fir_kernel_interleaved_avx512_f32, 8, 16},
+        {"avx2", [] { return __builtin_cpu_supports("avx2") != 0; }, fir_kernel_avx2, fir_kernel_avx2_f32,
+         fir_kernel_interleaved_avx2, fir_kernel_interleaved_avx2_f32, 4, 8},
+        {"sse2", [] { return __builtin_cpu_supports("sse2") != 0; }, fir_kernel_sse2, fir_kernel_sse2_f32,
+         fir_kernel_interleaved_sse2, fir_kernel_interleaved_sse2_f32, 2, 4},
+#endif
+        {"escalar", [] { return true; }, fir_kernel_scalar<double>, fir_kernel_scalar<float>,
+         fir_kernel_interleaved_scalar<double>, fir_kernel_interleaved_scalar<float>, 1, 1},
+    };
+    return variants;
+}
+
+// Escolhe, pelo CPUID, a variante mais larga suportada pelo processador
+static const FirKernelVariant& select_fir_kernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+#endif
+    for (const FirKernelVariant& variant : fir_kernel_variants()) {
+        if (variant.supported()) {
+            return variant;
+        }
+    }
+    return fir_kernel_variants().back();
+}
+
+// Escolhida uma única vez, na primeira chamada (sem depender da ordem de inicialização dos globais)
+const FirKernelVariant& selected_fir_kernel() {
+    static const FirKernelVariant& variant = select_fir_kernel();
+    return variant;
+}
+
+void fir_decimate_kernel(const double* coefficients, const double* const* taps, int filter_size, double* output, int count) {
+    selected_fir_kernel().f64(coefficients, taps, filter_size, output, count);
+}
+
+void fir_decimate_kernel(const float* coefficients, const float* const* taps, int filter_size, float* output, int count) {
+    selected_fir_kernel().f32(coefficients, taps, filter_size, output, count);
+}
+
+void fir_decimate_interleaved(const double* coefficients, int filter_size, const double* input, int channels, int factor, double* output, int count) {
+    selected_fir_kernel().interleaved_f64(coefficients, filter_size, input, channels, factor, output, count, 0, channels);
+}
+
+void fir_decimate_interleaved(const float* coefficients, int filter_size, const float* input, int channels, int factor, float* output, int count) {
+    selected_fir_kernel().interleaved_f32(coefficients, filter_size, input, channels, factor, output, count, 0, channels);
+}
+
+} // namespace freqcomp
@@ -0,0 +1,124 @@
+#include "freqcomp/resampler.h"
+#include "freqcomp/filter.h"
+#include "freqcomp/coefficient_bank.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+// A saída tem de ser idêntica bit a bit a resample_rational: sem FMA na soma
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+namespace freqcomp {
+
+template <typename Sample>
+Resampler<Sample>::Resampler(int input_rate, int output_rate, int channels, int zero_crossings) : channels(channels) {
+    if (input_rate < 1 || output_rate < 1 || channels < 1 || zero_crossings < 1) {
+        throw std::invalid_argument("Resampler: taxa, número de canais ou cruzamentos por zero inválidos");
+    }
+    int g = gcd(input_rate, output_rate);
+    L = output_rate / g; // Fator de interpolação
+    M = input_rate / g;  // Fator de decimação
+
+    // Mesmo protótipo de resample_rational: corte abaixo da menor frequência de Nyquist. Vem do banco
+    // compartilhado, então cada nova negociação com as mesmas taxas não o projeta de novo.
+    double cutoff = 0.45 * std::min(input_rate, output_rate);
+    int filter_order = 2 * zero_crossings * std::max(L, M);
+    const std::vector<double>& prototype = cached_fir_coefficients(filter_order, cutoff, (double) input_rate * L);
+
+    phase_length = (filter_order + L) / L;
+    bank.assign((size_t) L * phase_length, Sample(0));
+    for (int i = 0; i <= filter_order; i++) {
+        bank[(size_t) (i % L) * phase_length + i / L] = Sample(L * prototype[i]);
+    }
+    delay = filter_order / 2;
+    reset();
+}
+
+template <typename Sample>
+void Resampler<Sample>::reset() {
+    // phase_length - 1 quadros nulos antes do início, para a primeira saída ter a linha de atraso completa
+    history.assign((size_t) (phase_length - 1) * channels, Sample(0));
+    history_start = -(phase_length - 1);
+    received = 0;
+    next_output = 0;
+}
+
+template <typename Sample>
+int Resampler<Sample>::max_output(int count) const {
+    // Um bloco gera no máximo ceil(count * L / M) saídas; flush, as que esperavam o atraso de grupo
+    return (int) (((long long) count * L + M - 1) / M + (delay + M - 1) / M + 1);
+}
+
+template <typename Sample>
+size_t Resampler<Sample>::produce(long long available, long long limit, Sample* output) {
+    size_t produced = 0;
+    while (next_output < limit) {
+        long long t = next_output * M + delay;
+        long long n = t / L;
+        if (n >= available) {
+            break;
+        }
+        // Soma em ordem crescente de j, como resample_rational; os quadros fora do sinal são
+        // zeros e não alteram a soma
+        const Sample* h = bank.data() + (t % L) * phase_length;
+        const Sample* x = history.data() + (size_t) (n - history_start) * channels;
+        Sample* y = output + produced * channels;
+        for (int c = 0; c < channels; c++) {
+            Sample acc = 0;
+            for (int j = 0; j < phase_length; j++) {
+                acc += h[j] * x[c - (long) j * channels];
+            }
+            y[c] = acc;
+        }
+        produced++;
+        next_output++;
+    }
+
+    // Descarta os quadros que nenhuma saída futura vai usar
+    long long first_needed = (next_output * M + delay) / L - (phase_length - 1);
+    long long discard = std::min<long long>(first_needed - history_start, history.size() / channels);
+    if (discard > 0) {
+        history.erase(history.begin(), history.begin() + (size_t) discard * channels);
+        history_start += discard;
+    }
+    return produced;
+}
+
+template <typename Sample>
+size_t Resampler<Sample>::process(Span<const Sample> input, Span<Sample> output) {
+    int count = input.size() / channels;
+    if (output.size() < (size_t) max_output(count) * channels) {
+        throw std::length_error("Resampler::process: saída menor que max_output(quadros de entrada)");
+    }
+    history.insert(history.end(), input.data(), input.data() + (size_t) count * channels);
+    received += count;
+    return produce(received, std::numeric_limits<long long>::max(), output.data());
+}
+
+template <typename Sample>
+size_t Resampler<Sample>::flush(Span<Sample> output) {
+    if (output.size() < (size_t) max_output(0) * channels) {
+        throw std::length_error("Resampler::flush: saída menor que max_output(0)");
+    }
+    long long limit = (received * L + M - 1) / M;
+    if (next_output >= limit) {
+        return 0;
+    }
+    // Completa com zeros até o último quadro lido pela última saída
+    long long last = ((limit - 1) * M + delay) / L;
+    long long end = history_start + (long long) history.size() / channels;
+    if (last >= end) {
+        history.resize(history.size() + (size_t) (last + 1 - end) * channels, Sample(0));
+    }
+    return produce(last + 1, limit, output.data());
+}
+
+template class Resampler<double>;
+template class Resampler<float>;
+
+} // namespace freqcomp
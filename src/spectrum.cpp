@@ -0,0 +1,252 @@
+#include "freqcomp/spectrum.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace freqcomp {
+
+// Tipos de transformada além de FFTW_FORWARD e FFTW_BACKWARD
+enum { REAL_TO_COMPLEX = 2, COMPLEX_TO_REAL = 3 };
+
+static int alignment_of(void* a, void* b) {
+    return std::max(fftw_alignment_of(static_cast<double*>(a)), fftw_alignment_of(static_cast<double*>(b)));
+}
+
+FFTPlanCache& FFTPlanCache::instance() {
+    static FFTPlanCache cache;
+    return cache;
+}
+
+FFTPlanCache::FFTPlanCache() : planner_flags(FFTW_MEASURE), max_measured_size(1 << 16) {}
+
+FFTPlanCache::~FFTPlanCache() {
+    for (std::map<PlanKey, fftw_plan>::iterator it = plans.begin(); it != plans.end(); ++it) {
+        fftw_destroy_plan(it->second);
+    }
+}
+
+bool FFTPlanCache::PlanKey::operator<(const PlanKey& other) const {
+    if (size != other.size) return size < other.size;
+    if (kind != other.kind) return kind < other.kind;
+    if (alignment != other.alignment) return alignment < other.alignment;
+    return in_place < other.in_place;
+}
+
+void FFTPlanCache::set_planner_flags(unsigned flags) {
+    std::lock_guard<std::mutex> lock(mutex);
+    planner_flags = flags;
+}
+
+bool FFTPlanCache::import_wisdom(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fftw_import_wisdom_from_filename(path.c_str()) != 0;
+}
+
+bool FFTPlanCache::export_wisdom(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fftw_export_wisdom_to_filename(path.c_str()) != 0;
+}
+
+// Busca o plano no cache ou cria com make(flags). O planejamento com FFTW_MEASURE sobrescreve
+// os arrays, então make usa arrays temporários com o mesmo alinhamento.
+template <typename Make>
+fftw_plan FFTPlanCache::find_or_plan(const PlanKey& key, Make make) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<PlanKey, fftw_plan>::iterator it = plans.find(key);
+    if (it != plans.end()) {
+        return it->second;
+    }
+
+    // Primeiro tenta o wisdom já carregado; sem ele, medir só compensa em tamanhos moderados
+    unsigned alignment_flag = key.alignment != 0 ? FFTW_UNALIGNED : 0;
+    fftw_plan plan = make(planner_flags | alignment_flag | FFTW_WISDOM_ONLY);
+    if (!plan) {
+        unsigned flags = key.size <= max_measured_size ? planner_flags : FFTW_ESTIMATE;
+        plan = make(flags | alignment_flag);
+    }
+
+    plans[key] = plan;
+    return plan;
+}
+
+fftw_plan FFTPlanCache::dft(int N, int sign, fftw_complex* in, fftw_complex* out) {
+    PlanKey key = {N, sign, alignment_of(in, out), in == out};
+    return find_or_plan(key, [&](unsigned flags) {
+        fftw_complex* scratch_in = fftw_alloc_complex(N);
+        fftw_complex* scratch_out = key.in_place ? scratch_in : fftw_alloc_complex(N);
+        fftw_plan plan = fftw_plan_dft_1d(N, scratch_in, scratch_out, sign, flags);
+        if (!key.in_place) {
+            fftw_free(scratch_out);
+        }
+        fftw_free(scratch_in);
+        return plan;
+    });
+}
+
+fftw_plan FFTPlanCache::r2c(int N, double* in, fftw_complex* out) {
+    PlanKey key = {N, REAL_TO_COMPLEX, alignment_of(in, out), false};
+    return find_or_plan(key, [&](unsigned flags) {
+        double* scratch_in = fftw_alloc_real(N);
+        fftw_complex* scratch_out = fftw_alloc_complex(N / 2 + 1);
+        fftw_plan plan = fftw_plan_dft_r2c_1d(N, scratch_in, scratch_out, flags);
+        fftw_free(scratch_out);
+        fftw_free(scratch_in);
+        return plan;
+    });
+}
+
+fftw_plan FFTPlanCache::c2r(int N, fftw_complex* in, double* out) {
+    PlanKey key = {N, COMPLEX_TO_REAL, alignment_of(out, in), false};
+    return find_or_plan(key, [&](unsigned flags) {
+        fftw_complex* scratch_in = fftw_alloc_complex(N / 2 + 1);
+        double* scratch_out = fftw_alloc_real(N);
+        fftw_plan plan = fftw_plan_dft_c2r_1d(N, scratch_in, scratch_out, flags);
+        fftw_free(scratch_out);
+        fftw_free(scratch_in);
+        return plan;
+    });
+}
+
+// Arquivo de wisdom: variável de ambiente FFTW_WISDOM ou media/fftw_wisdom.dat
+std::string fft_wisdom_file() {
+    const char* path = std::getenv("FFTW_WISDOM");
+    return path ? path : "media/fftw_wisdom.dat";
+}
+
+// Carrega o wisdom salvo e aplica o rigor pedido em FFTW_RIGOR (estimate, measure ou patient)
+void load_fft_wisdom() {
+    const char* rigor = std::getenv("FFTW_RIGOR");
+    if (rigor && std::string(rigor) == "estimate") {
+        FFTPlanCache::instance().set_planner_flags(FFTW_ESTIMATE);
+    } else if (rigor && std::string(rigor) == "patient") {
+        FFTPlanCache::instance().set_planner_flags(FFTW_PATIENT);
+    }
+    FFTPlanCache::instance().import_wisdom(fft_wisdom_file());
+}
+
+// Salva o wisdom acumulado para as próximas execuções
+void save_fft_wisdom() {
+    if (!FFTPlanCache::instance().export_wisdom(fft_wisdom_file())) {
+        std::cerr << "Aviso: não foi possível salvar o wisdom do FFTW em " << fft_wisdom_file() << std::endl;
+    }
+}
+
+// Aplicação da FFT (real -> complexo) para análise de frequência.
+// Como o sinal é real, o espectro é hermitiano e basta guardar os N/2 + 1 primeiros bins.
+std::vector<std::complex<double>> computeFFT(const std::vector<double>& signal) {
+    int N = signal.size();
+    if (N < 512) {
+        std::cerr << "Erro: Sinal muito curto para FFT!" << std::endl;
+        return {};
+    }
+
+    int bins = N / 2 + 1;
+    double* in = fftw_alloc_real(N);
+    fftw_complex* out = fftw_alloc_complex(bins);
+
+    std::copy(signal.begin(), signal.end(), in);
+
+    fftw_plan p = FFTPlanCache::instance().r2c(N, in, out);
+    fftw_execute_dft_r2c(p, in, out);
+
+    std::vector<std::complex<double>> spectrum(bins);
+    for (int i = 0; i < bins; i++) {
+        spectrum[i] = std::complex<double>(out[i][0], out[i][1]);
+    }
+
+    fftw_free(in);
+    fftw_free(out);
+
+    return spectrum;
+}
+
+// As N magnitudes, espelhando a metade guardada (|X[N - i]| = |X[i]| para sinais reais)
+std::vector<double> magnitude_spectrum(const std::vector<std::complex<double>>& spectrum, int N) {
+    if (spectrum.empty()) {
+        return {};
+    }
+    std::vector<double> magnitudes(N);
+    for (int i = 0; i < N; i++) {
+        int bin = i < (int) spectrum.size() ? i : N - i;
+        magnitudes[i] = std::abs(spectrum[bin]);
+    }
+    return magnitudes;
+}
+
+// Função para salvar FFT no arquivo (as N magnitudes, espelhando a metade guardada)
+void saveFFTtoFile(const std::vector<std::complex<double>>& spectrum, int N, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Erro ao abrir " << filename << " para escrita!" << std::endl;
+        return;
+    }
+
+    for (double magnitude : magnitude_spectrum(spectrum, N)) {
+        file << magnitude << "\n";  // Escrevendo magnitude da FFT
+    }
+
+    file.close();
+    std::cout << "FFT salva em: " << filename << std::endl;
+}
+
+// Redução de frequência pelo corte de espectro (só os N/2 + 1 bins não negativos)
+std::vector<std::complex<double>> reduceFrequency(const std::vector<std::complex<double>>& spectrum, int original_rate, int target_rate) {
+    int bins = spectrum.size();
+    int cutoff = (int) (((long long) target_rate * (bins - 1)) / original_rate);
+    std::vector<std::complex<double>> new_spectrum(bins, std::complex<double>(0, 0));
+
+    for (int i = 0; i < cutoff && i < bins; i++) {
+        new_spectrum[i] = spectrum[i];
+    }
+
+    return new_spectrum;
+}
+
+// Decimação espectral: recorta o espectro na banda de destino para uma IFFT de tamanho
+// output_size = N * target_rate / original_rate. O sinal resultante tem de fato menos amostras
+// (em vez de N amostras rotuladas com a taxa menor). Com output_size > N completa com zeros.
+std::vector<std::complex<double>> cropSpectrum(const std::vector<std::complex<double>>& spectrum, int N, int output_size) {
+    int output_bins = output_size / 2 + 1;
+    // O bin de Nyquist de um tamanho par é descartado (não há como representá-lo sem ambiguidade)
+    int kept = std::min<int>(spectrum.size(), output_size % 2 == 0 ? output_size / 2 : output_bins);
+    if (N % 2 == 0) {
+        kept = std::min(kept, N / 2);
+    }
+
+    // Fator output_size / N: a IFFT divide por output_size, a FFT original somou N amostras
+    double scale = (double) output_size / N;
+    std::vector<std::complex<double>> cropped(output_bins, std::complex<double>(0, 0));
+    for (int i = 0; i < kept; i++) {
+        cropped[i] = spectrum[i] * scale;
+    }
+    return cropped;
+}
+
+// Aplicação da IFFT (complexo -> real) para reconstruir as N amostras do sinal
+std::vector<double> computeIFFT(const std::vector<std::complex<double>>& spectrum, int N) {
+    int bins = N / 2 + 1;
+    fftw_complex* in = fftw_alloc_complex(bins);
+    double* out = fftw_alloc_real(N);
+
+    for (int i = 0; i < bins; i++) {
+        in[i][0] = spectrum[i].real();
+        in[i][1] = spectrum[i].imag();
+    }
+
+    fftw_plan p = FFTPlanCache::instance().c2r(N, in, out);
+    fftw_execute_dft_c2r(p, in, out);
+
+    std::vector<double> signal(N);
+    for (int i = 0; i < N; i++) {
+        signal[i] = out[i] / N;
+    }
+
+    fftw_free(in);
+    fftw_free(out);
+
+    return signal;
+}
+
+} // namespace freqcomp